@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ActorActions/PoissonDiskSampler.h"
+#include "Async/ParallelFor.h"
+
+bool FPoissonDiskSampler::GeneratePoints(const FBox2D& Bounds, float MinDistance, int32 Seed,
+	TFunctionRef<bool(const FVector2D&)> IsPointInside, TArray<FVector2D>& OutPoints, int32 MaxAttemptsPerCell)
+{
+	OutPoints.Reset();
+
+	if (!Bounds.bIsValid || MinDistance <= 0.f || MaxAttemptsPerCell <= 0) return false;
+
+	//With this cell size a cell can hold at most one sample.
+	const double CellSize = MinDistance / UE_SQRT_2;
+	const double MinDistanceSquared = FMath::Square((double)MinDistance);
+	const FVector2D BoundsSize = Bounds.GetSize();
+
+	const int32 GridWidth = FMath::Max(1, FMath::CeilToInt32(BoundsSize.X / CellSize));
+	const int32 GridHeight = FMath::Max(1, FMath::CeilToInt32(BoundsSize.Y / CellSize));
+
+	if ((int64)GridWidth * GridHeight > MaxGridCells) return false;
+
+	TArray<FVector2D> CellPoints;
+	CellPoints.SetNumUninitialized(GridWidth * GridHeight);
+
+	//One byte per cell, so neighbouring tiles never write to the same memory word.
+	TArray<uint8> CellOccupied;
+	CellOccupied.SetNumZeroed(GridWidth * GridHeight);
+
+	const int32 TilesX = FMath::DivideAndRoundUp(GridWidth, TileSizeInCells);
+	const int32 TilesY = FMath::DivideAndRoundUp(GridHeight, TileSizeInCells);
+
+	auto SampleTile = [&](int32 TileX, int32 TileY)
+	{
+		FRandomStream TileStream(HashCombine(GetTypeHash(Seed), GetTypeHash(TileY * TilesX + TileX)));
+
+		const int32 CellStartX = TileX * TileSizeInCells;
+		const int32 CellStartY = TileY * TileSizeInCells;
+		const int32 CellEndX = FMath::Min(CellStartX + TileSizeInCells, GridWidth);
+		const int32 CellEndY = FMath::Min(CellStartY + TileSizeInCells, GridHeight);
+
+		for (int32 CellY = CellStartY; CellY < CellEndY; CellY++)
+		{
+			for (int32 CellX = CellStartX; CellX < CellEndX; CellX++)
+			{
+				for (int32 Attempt = 0; Attempt < MaxAttemptsPerCell; Attempt++)
+				{
+					const FVector2D Candidate(
+						Bounds.Min.X + (CellX + TileStream.GetFraction()) * CellSize,
+						Bounds.Min.Y + (CellY + TileStream.GetFraction()) * CellSize);
+
+					if (Candidate.X > Bounds.Max.X || Candidate.Y > Bounds.Max.Y) continue;
+
+					bool bTooClose = false;
+
+					for (int32 NeighbourY = FMath::Max(0, CellY - 2); NeighbourY <= FMath::Min(GridHeight - 1, CellY + 2) && !bTooClose; NeighbourY++)
+					{
+						for (int32 NeighbourX = FMath::Max(0, CellX - 2); NeighbourX <= FMath::Min(GridWidth - 1, CellX + 2); NeighbourX++)
+						{
+							const int32 NeighbourIndex = NeighbourY * GridWidth + NeighbourX;
+
+							if (CellOccupied[NeighbourIndex] &&
+								FVector2D::DistSquared(CellPoints[NeighbourIndex], Candidate) < MinDistanceSquared)
+							{
+								bTooClose = true;
+								break;
+							}
+						}
+					}
+
+					if (bTooClose || !IsPointInside(Candidate)) continue;
+
+					const int32 CellIndex = CellY * GridWidth + CellX;
+					CellPoints[CellIndex] = Candidate;
+					CellOccupied[CellIndex] = 1;
+					break;
+				}
+			}
+		}
+	};
+
+	//Tiles of one colour are a whole tile apart, which is wider than the neighbourhood checked above.
+	for (int32 Phase = 0; Phase < 4; Phase++)
+	{
+		const int32 PhaseOffsetX = Phase & 1;
+		const int32 PhaseOffsetY = Phase >> 1;
+
+		const int32 PhaseTilesX = (TilesX - PhaseOffsetX + 1) / 2;
+		const int32 PhaseTilesY = (TilesY - PhaseOffsetY + 1) / 2;
+
+		ParallelFor(PhaseTilesX * PhaseTilesY, [&](int32 PhaseTileIndex)
+		{
+			const int32 TileX = (PhaseTileIndex % PhaseTilesX) * 2 + PhaseOffsetX;
+			const int32 TileY = (PhaseTileIndex / PhaseTilesX) * 2 + PhaseOffsetY;
+
+			SampleTile(TileX, TileY);
+		});
+	}
+
+	for (int32 CellIndex = 0; CellIndex < CellOccupied.Num(); CellIndex++)
+	{
+		if (CellOccupied[CellIndex])
+		{
+			OutPoints.Add(CellPoints[CellIndex]);
+		}
+	}
+
+	return true;
+
+}//GeneratePoints.
@@ -3,8 +3,34 @@
 
 #include "ActorActions/QuickActorActionsWidget.h"
 #include "Subsystems/EditorActorSubsystem.h"
+#include "ScopedTransaction.h"
+#include "ActorActions/PoissonDiskSampler.h"
+#include "Components/SplineComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "GameFramework/Volume.h"
+
 #include "DebugHeader.h"
 
+//Spatial hash key, actors only share a key when mesh and class match and they sit in the same grid cell.
+struct FDuplicateActorKey
+{
+	const UObject* MeshOrClass = nullptr;
+	const UClass* ActorClass = nullptr;
+	FIntVector Cell;
+
+	bool operator==(const FDuplicateActorKey& Other) const
+	{
+		return MeshOrClass == Other.MeshOrClass && ActorClass == Other.ActorClass && Cell == Other.Cell;
+	}
+
+	friend uint32 GetTypeHash(const FDuplicateActorKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.MeshOrClass), GetTypeHash(Key.ActorClass));
+		return HashCombine(Hash, GetTypeHash(Key.Cell));
+	}
+};
+
 void UQuickActorActionsWidget::SelectAllActorWithSimilarName()
 {
 	if (!GetEditorActorSubsystem())return;
@@ -124,12 +150,7 @@ void UQuickActorActionsWidget::DuplicateActors()
 
 void UQuickActorActionsWidget::Randomize()
 {
-	const bool bConditionNotSet = !RandomActorRotation.bRandomizeRotYaw &&
-		!RandomActorRotation.bRandomizeRotPitch &&
-		!RandomActorRotation.bRandomizeRotRoll &&
-		!bRandomizeScale && !bRandomizeOffset;
-
-	if (bConditionNotSet)
+	if (!HasRandomizeConditionSet())
 	{
 		DebugHeader::ShowNotifyInfo(TEXT("No variation condition specified"));
 		return;
@@ -146,50 +167,739 @@ void UQuickActorActionsWidget::Randomize()
 		return;
 	}
 
-	for (AActor* SelectedActor : SelectedActors)
+	if (!bUseFixedSeed)
 	{
+		RandomSeed = FMath::Rand();
+	}
+
+	//Draw every random value up front from one stream, so the same seed and selection always give the same result.
+	TArray<FRandomTransformSample> RandomSamples;
+	GenerateRandomTransformSamples(RandomSeed, SelectedActors.Num(), RandomSamples);
+
+	const FScopedTransaction Transaction(FText::FromString(TEXT("Randomize Actor Transforms")));
+
+	for (int32 ActorIndex = 0; ActorIndex < SelectedActors.Num(); ActorIndex++)
+	{
+		AActor* SelectedActor = SelectedActors[ActorIndex];
+
 		if (!SelectedActor)continue;
 
-		if (RandomActorRotation.bRandomizeRotYaw)
+		const FTransform RandomizedTransform =
+			ApplyRandomTransformSample(SelectedActor->GetActorTransform(), RandomSamples[ActorIndex]);
+
+		//One transform update per actor instead of one per randomized channel.
+		SelectedActor->Modify();
+		SelectedActor->SetActorTransform(RandomizedTransform);
+
+		Counter++;
+	}
+
+	if(Counter >0)
+	DebugHeader::ShowNotifyInfo(TEXT("Successfully set ")+
+	FString::FromInt(Counter)+TEXT(" actors with seed ") + FString::FromInt(RandomSeed));
+
+
+}//Randomize.
+
+void UQuickActorActionsWidget::ScatterActors()
+{
+	if (!GetEditorActorSubsystem())return;
+
+	TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
+
+	AActor* TemplateActor = nullptr;
+	AActor* VolumeActor = nullptr;
+
+	if (!FindScatterTemplateAndVolume(SelectedActors, TemplateActor, VolumeActor)) return;
+
+	if (!bUseFixedSeed)
+	{
+		RandomSeed = FMath::Rand();
+	}
+
+	const double SamplingStartTime = FPlatformTime::Seconds();
+
+	TArray<FVector> ScatterPoints;
+	if (!GenerateScatterPoints(VolumeActor, RandomSeed, ScatterPoints)) return;
+
+	const double SamplingSeconds = FPlatformTime::Seconds() - SamplingStartTime;
+
+	if (ScatterPoints.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No point fits inside the scatter volume"));
+		return;
+	}
+
+	TArray<FRandomTransformSample> RandomSamples;
+	const bool bApplyRandomSamples = bRandomizeScatteredTransforms && HasRandomizeConditionSet();
+
+	if (bApplyRandomSamples)
+	{
+		GenerateRandomTransformSamples(RandomSeed, ScatterPoints.Num(), RandomSamples);
+	}
+
+	const FTransform TemplateTransform = TemplateActor->GetActorTransform();
+
+	TArray<FTransform> ScatterTransforms;
+	ScatterTransforms.Reserve(ScatterPoints.Num());
+
+	for (int32 PointIndex = 0; PointIndex < ScatterPoints.Num(); PointIndex++)
+	{
+		FTransform PointTransform = TemplateTransform;
+		PointTransform.SetTranslation(ScatterPoints[PointIndex]);
+
+		if (bApplyRandomSamples)
 		{
-			const float RandomRotYawValue = FMath::FRandRange(RandomActorRotation.RotYawMin, RandomActorRotation.RotYawMax);
-			SelectedActor->AddActorWorldRotation(FRotator(0.f, RandomRotYawValue, 0.f));
+			PointTransform = ApplyRandomTransformSample(PointTransform, RandomSamples[PointIndex]);
 		}
 
-		if (RandomActorRotation.bRandomizeRotPitch)
+		ScatterTransforms.Add(PointTransform);
+	}
+
+	const double SpawnStartTime = FPlatformTime::Seconds();
+	int32 Counter = 0;
+	{
+		const FScopedTransaction Transaction(FText::FromString(TEXT("Scatter Actors")));
+
+		Counter = bScatterAsInstances ?
+			SpawnScatteredInstances(TemplateActor, ScatterTransforms) :
+			SpawnScatteredActors(TemplateActor, ScatterTransforms);
+	}
+	const double SpawnSeconds = FPlatformTime::Seconds() - SpawnStartTime;
+
+	if (Counter > 0)
+	{
+		DebugHeader::ShowNotifyInfo(FString::Printf(TEXT("Successfully scattered %d %s with seed %d\nSampling: %.1f ms, Spawning: %.1f ms"),
+			Counter, bScatterAsInstances ? TEXT("instances") : TEXT("actors"), RandomSeed,
+			SamplingSeconds * 1000.0, SpawnSeconds * 1000.0));
+	}
+
+}//ScatterActors.
+
+void UQuickActorActionsWidget::DropActorsToSurface()
+{
+	if (PendingDropTraces.Num() > 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Drop to surface is still running"));
+		return;
+	}
+
+	if (!GetEditorActorSubsystem())return;
+
+	TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
+
+	if (SelectedActors.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No actor selected"));
+		return;
+	}
+
+	UWorld* World = SelectedActors[0] ? SelectedActors[0]->GetWorld() : nullptr;
+	if (!World) return;
+
+	DropTraceWorld = World;
+	DropTraceDelegate.BindUObject(this, &UQuickActorActionsWidget::OnDropTraceCompleted);
+	NumOfDropTracesCompleted = 0;
+	NumOfDropTraceFramesWaited = 0;
+	DropTraceStartTime = FPlatformTime::Seconds();
+
+	PendingDropTraces.Reserve(SelectedActors.Num());
+
+	for (AActor* SelectedActor : SelectedActors)
+	{
+		if (!SelectedActor) continue;
+
+		FVector BoundsOrigin;
+		FVector BoundsExtent;
+		SelectedActor->GetActorBounds(true, BoundsOrigin, BoundsExtent);
+
+		FPendingDropTrace& PendingTrace = PendingDropTraces.AddDefaulted_GetRef();
+		PendingTrace.Actor = SelectedActor;
+		PendingTrace.PivotHeight = SelectedActor->GetActorLocation().Z - (BoundsOrigin.Z - BoundsExtent.Z);
+		PendingTrace.TraceStart = SelectedActor->GetActorLocation();
+		PendingTrace.TraceEnd = PendingTrace.TraceStart - FVector(0.f, 0.f, DropTraceDistance);
+	}
+
+	//Issue the whole batch up front, results come back through the delegate when the world runs its trace pipeline.
+	for (int32 TraceIndex = 0; TraceIndex < PendingDropTraces.Num(); TraceIndex++)
+	{
+		const FPendingDropTrace& PendingTrace = PendingDropTraces[TraceIndex];
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SuperManagerDropToSurface), true, PendingTrace.Actor.Get());
+
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, PendingTrace.TraceStart, PendingTrace.TraceEnd,
+			DropTraceChannel, QueryParams, FCollisionResponseParams::DefaultResponseParam,
+			&DropTraceDelegate, (uint32)TraceIndex);
+	}
+
+	DropTraceTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UQuickActorActionsWidget::TickPendingDropTraces));
+
+}//DropActorsToSurface.
+
+void UQuickActorActionsWidget::SelectOverlappingDuplicates()
+{
+	if (!GetEditorActorSubsystem())return;
+
+	TArray<TArray<AActor*>> DuplicateGroups;
+	FindOverlappingDuplicates(DuplicateGroups);
+
+	if (DuplicateGroups.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No overlapping duplicate actor found"));
+		return;
+	}
+
+	for (const TArray<AActor*>& DuplicateGroup : DuplicateGroups)
+	{
+		FString GroupLabels = DuplicateGroup[0]->GetActorLabel() + TEXT(" is stacked with:");
+
+		for (int32 ActorIndex = 1; ActorIndex < DuplicateGroup.Num(); ActorIndex++)
 		{
-			const float RandomRotPitchValue = FMath::FRandRange(RandomActorRotation.RotPitchMin, RandomActorRotation.RotPitchMax);
-			SelectedActor->AddActorWorldRotation(FRotator(RandomRotPitchValue,0.f,  0.f));
+			GroupLabels.Append(TEXT(" "));
+			GroupLabels.Append(DuplicateGroup[ActorIndex]->GetActorLabel());
 		}
+		DebugHeader::PrintLog(GroupLabels);
+	}
+
+	TArray<AActor*> ExtraCopies;
+	GetExtraDuplicateCopies(DuplicateGroups, ExtraCopies);
+
+	EditorActorSubsystem->SetSelectedLevelActors(ExtraCopies);
+
+	DebugHeader::ShowNotifyInfo(TEXT("Selected ") + FString::FromInt(ExtraCopies.Num()) +
+		TEXT(" duplicates in ") + FString::FromInt(DuplicateGroups.Num()) + TEXT(" stacks, see output log for details"));
+
+}//SelectOverlappingDuplicates.
+
+void UQuickActorActionsWidget::DeleteOverlappingDuplicates()
+{
+	if (!GetEditorActorSubsystem())return;
+
+	TArray<TArray<AActor*>> DuplicateGroups;
+	FindOverlappingDuplicates(DuplicateGroups);
+
+	TArray<AActor*> ExtraCopies;
+	GetExtraDuplicateCopies(DuplicateGroups, ExtraCopies);
+
+	if (ExtraCopies.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No overlapping duplicate actor found"));
+		return;
+	}
+
+	const EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
+		FString::FromInt(ExtraCopies.Num()) + TEXT(" duplicate actors found in ") +
+		FString::FromInt(DuplicateGroups.Num()) + TEXT(" stacks.\nDelete them and keep one actor per stack?"));
+
+	if (ConfirmResult != EAppReturnType::Yes) return;
+
+	const FScopedTransaction Transaction(FText::FromString(TEXT("Delete Overlapping Duplicates")));
+
+	if (EditorActorSubsystem->DestroyActors(ExtraCopies))
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully deleted ") + FString::FromInt(ExtraCopies.Num()) + TEXT(" duplicate actors"));
+	}
+
+}//DeleteOverlappingDuplicates.
+
+#pragma region RandomizeActorTransformCore
+
+bool UQuickActorActionsWidget::HasRandomizeConditionSet() const
+{
+	return RandomActorRotation.bRandomizeRotYaw ||
+		RandomActorRotation.bRandomizeRotPitch ||
+		RandomActorRotation.bRandomizeRotRoll ||
+		bRandomizeScale || bRandomizeOffset;
+
+}//HasRandomizeConditionSet.
+
+void UQuickActorActionsWidget::GenerateRandomTransformSamples(int32 Seed, int32 NumOfSamples, TArray<FRandomTransformSample>& OutSamples) const
+{
+	FRandomStream RandomStream(Seed);
+
+	OutSamples.SetNumUninitialized(NumOfSamples);
+
+	for (FRandomTransformSample& Sample : OutSamples)
+	{
+		//Always draw all five values so the sequence doesn't depend on which conditions are enabled.
+		const float RandomYaw = RandomStream.FRandRange(RandomActorRotation.RotYawMin, RandomActorRotation.RotYawMax);
+		const float RandomPitch = RandomStream.FRandRange(RandomActorRotation.RotPitchMin, RandomActorRotation.RotPitchMax);
+		const float RandomRoll = RandomStream.FRandRange(RandomActorRotation.RotRollMin, RandomActorRotation.RotRollMax);
+		const float RandomScale = RandomStream.FRandRange(ScaleMin, ScaleMax);
+		const float RandomOffset = RandomStream.FRandRange(OffsetMin, OffsetMax);
+
+		Sample.Yaw = RandomActorRotation.bRandomizeRotYaw ? RandomYaw : 0.f;
+		Sample.Pitch = RandomActorRotation.bRandomizeRotPitch ? RandomPitch : 0.f;
+		Sample.Roll = RandomActorRotation.bRandomizeRotRoll ? RandomRoll : 0.f;
+		Sample.Scale = RandomScale;
+		Sample.Offset = bRandomizeOffset ? RandomOffset : 0.f;
+	}
+
+}//GenerateRandomTransformSamples.
+
+FTransform UQuickActorActionsWidget::ApplyRandomTransformSample(const FTransform& BaseTransform, const FRandomTransformSample& Sample) const
+{
+	FTransform RandomizedTransform = BaseTransform;
+
+	//Same order as applying yaw, pitch then roll as separate world rotations.
+	const FQuat DeltaRotation =
+		FQuat(FRotator(0.f, 0.f, Sample.Roll)) *
+		FQuat(FRotator(Sample.Pitch, 0.f, 0.f)) *
+		FQuat(FRotator(0.f, Sample.Yaw, 0.f));
+
+	RandomizedTransform.SetRotation(DeltaRotation * BaseTransform.GetRotation());
+
+	if (bRandomizeScale)
+	{
+		RandomizedTransform.SetScale3D(FVector(Sample.Scale));
+	}
+
+	RandomizedTransform.AddToTranslation(FVector(Sample.Offset, Sample.Offset, 0.f));
 
-		if (RandomActorRotation.bRandomizeRotRoll)
+	return RandomizedTransform;
+
+}//ApplyRandomTransformSample.
+
+#pragma endregion
+
+#pragma region ActorScatterCore
+
+bool UQuickActorActionsWidget::FindScatterTemplateAndVolume(const TArray<AActor*>& SelectedActors, AActor*& OutTemplateActor, AActor*& OutVolumeActor)
+{
+	if (SelectedActors.Num() != 2)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Select the actor to scatter and one volume or spline actor"));
+		return false;
+	}
+
+	for (AActor* SelectedActor : SelectedActors)
+	{
+		if (!SelectedActor) continue;
+
+		const bool bCanBeVolume = SelectedActor->IsA<AVolume>() ||
+			SelectedActor->FindComponentByClass<USplineComponent>() != nullptr;
+
+		if (bCanBeVolume && !OutVolumeActor)
 		{
-			const float RandomRotRollValue = FMath::FRandRange(RandomActorRotation.RotRollMin, RandomActorRotation.RotRollMax);
-			SelectedActor->AddActorWorldRotation(FRotator(0.f, 0.f, RandomRotRollValue));
+			OutVolumeActor = SelectedActor;
 		}
+		else
+		{
+			OutTemplateActor = SelectedActor;
+		}
+	}
+
+	if (!OutVolumeActor || !OutTemplateActor)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No volume or spline actor found in selection"));
+		return false;
+	}
+
+	if (bScatterAsInstances)
+	{
+		UStaticMeshComponent* TemplateMeshComponent = OutTemplateActor->FindComponentByClass<UStaticMeshComponent>();
 
-		if (bRandomizeScale)
+		if (!TemplateMeshComponent || !TemplateMeshComponent->GetStaticMesh())
 		{
-			SelectedActor->SetActorScale3D(FVector(FMath::FRandRange(ScaleMin, ScaleMax)));
+			DebugHeader::ShowNotifyInfo(OutTemplateActor->GetActorLabel() + TEXT(" has no static mesh to instance"));
+			return false;
+		}
+	}
+
+	return true;
+
+}//FindScatterTemplateAndVolume.
+
+//Points are placed at the top of the volume, so they can be dropped to the surface afterwards.
+bool UQuickActorActionsWidget::GenerateScatterPoints(AActor* VolumeActor, int32 Seed, TArray<FVector>& OutPoints)
+{
+	const FTransform VolumeTransform = VolumeActor->GetActorTransform();
 
+	TArray<FVector2D> SplinePolygon;
+	FBox2D SampleBounds(ForceInit);
+	FBox LocalVolumeBox(ForceInit);
+	double PointsHeight = -UE_BIG_NUMBER;
+
+	if (USplineComponent* SplineComponent = VolumeActor->FindComponentByClass<USplineComponent>())
+	{
+		//An open spline would be closed by a straight chord the user never drew.
+		if (!SplineComponent->IsClosedLoop())
+		{
+			DebugHeader::ShowMsgDialog(EAppMsgType::Ok, VolumeActor->GetActorLabel() +
+				TEXT(" has an open spline. Enable Closed Loop on it to scatter inside."), false);
+			return false;
 		}
 
-		if (bRandomizeOffset)
+		const float SplineLength = SplineComponent->GetSplineLength();
+		const int32 NumOfSegments = FMath::Clamp(SplineComponent->GetNumberOfSplinePoints() * 16, 16, 4096);
+
+		for (int32 SegmentIndex = 0; SegmentIndex < NumOfSegments; SegmentIndex++)
+		{
+			const FVector SplineLocation = SplineComponent->GetLocationAtDistanceAlongSpline(
+				SplineLength * SegmentIndex / NumOfSegments, ESplineCoordinateSpace::World);
+
+			SplinePolygon.Add(FVector2D(SplineLocation.X, SplineLocation.Y));
+			SampleBounds += SplinePolygon.Last();
+			PointsHeight = FMath::Max(PointsHeight, SplineLocation.Z);
+		}
+	}
+	else
+	{
+		LocalVolumeBox = VolumeActor->CalculateComponentsBoundingBoxInLocalSpace(true);
+
+		if (!LocalVolumeBox.IsValid)
+		{
+			DebugHeader::ShowNotifyInfo(VolumeActor->GetActorLabel() + TEXT(" has no bounds to scatter inside"));
+			return false;
+		}
+
+		const FBox WorldVolumeBox = LocalVolumeBox.TransformBy(VolumeTransform);
+
+		SampleBounds = FBox2D(FVector2D(WorldVolumeBox.Min.X, WorldVolumeBox.Min.Y), FVector2D(WorldVolumeBox.Max.X, WorldVolumeBox.Max.Y));
+		PointsHeight = WorldVolumeBox.Max.Z;
+	}
+
+	//Even-odd test against the sampled spline, or the volume's box in its own space.
+	auto IsPointInside = [&SplinePolygon, &LocalVolumeBox, &VolumeTransform](const FVector2D& Point)
+	{
+		if (SplinePolygon.Num() > 0)
+		{
+			bool bInside = false;
+
+			for (int32 Current = 0, Previous = SplinePolygon.Num() - 1; Current < SplinePolygon.Num(); Previous = Current++)
+			{
+				const FVector2D& A = SplinePolygon[Current];
+				const FVector2D& B = SplinePolygon[Previous];
+
+				if (((A.Y > Point.Y) != (B.Y > Point.Y)) &&
+					(Point.X < (B.X - A.X) * (Point.Y - A.Y) / (B.Y - A.Y) + A.X))
+				{
+					bInside = !bInside;
+				}
+			}
+			return bInside;
+		}
+
+		const FVector LocalPoint = VolumeTransform.InverseTransformPosition(
+			FVector(Point.X, Point.Y, VolumeTransform.GetLocation().Z));
+
+		return LocalPoint.X >= LocalVolumeBox.Min.X && LocalPoint.X <= LocalVolumeBox.Max.X &&
+			LocalPoint.Y >= LocalVolumeBox.Min.Y && LocalPoint.Y <= LocalVolumeBox.Max.Y;
+	};
+
+	if (SplinePolygon.Num() > 0 && SplinePolygon.Num() < 3)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Spline needs at least three points to scatter inside"));
+		return false;
+	}
+
+	TArray<FVector2D> Points2D;
+
+	if (!FPoissonDiskSampler::GeneratePoints(SampleBounds, ScatterMinDistance, Seed, IsPointInside, Points2D))
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Scatter volume is too large for the minimum distance"));
+		return false;
+	}
+
+	//Keep the cap spatially even by dropping a shuffled subset rather than the last sampled tiles.
+	if (Points2D.Num() > ScatterMaxPoints)
+	{
+		FRandomStream ShuffleStream(Seed);
+
+		for (int32 PointIndex = Points2D.Num() - 1; PointIndex > 0; PointIndex--)
 		{
-			const float RandomOffsetValue = FMath::FRandRange(OffsetMin, OffsetMax);
-			SelectedActor->AddActorWorldOffset(FVector(RandomOffsetValue, RandomOffsetValue, 0.f));
+			Points2D.Swap(PointIndex, ShuffleStream.RandRange(0, PointIndex));
 		}
-			
+		Points2D.SetNum(ScatterMaxPoints);
+	}
+
+	OutPoints.Reserve(Points2D.Num());
+
+	for (const FVector2D& Point : Points2D)
+	{
+		OutPoints.Add(FVector(Point.X, Point.Y, PointsHeight));
+	}
+
+	return true;
+
+}//GenerateScatterPoints.
+
+int32 UQuickActorActionsWidget::SpawnScatteredActors(AActor* TemplateActor, const TArray<FTransform>& ScatterTransforms)
+{
+	UWorld* World = TemplateActor->GetWorld();
+	if (!World) return 0;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Template = TemplateActor;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	int32 Counter = 0;
+
+	for (const FTransform& ScatterTransform : ScatterTransforms)
+	{
+		if (World->SpawnActor(TemplateActor->GetClass(), &ScatterTransform, SpawnParams))
+		{
 			Counter++;
-		
+		}
 	}
 
-	if(Counter >0)
-	DebugHeader::ShowNotifyInfo(TEXT("Successfully set ")+
-	FString::FromInt(Counter)+TEXT(" actors"));
+	return Counter;
 
+}//SpawnScatteredActors.
 
-}//Randomize.
+int32 UQuickActorActionsWidget::SpawnScatteredInstances(AActor* TemplateActor, const TArray<FTransform>& ScatterTransforms)
+{
+	UWorld* World = TemplateActor->GetWorld();
+	UStaticMeshComponent* TemplateMeshComponent = TemplateActor->FindComponentByClass<UStaticMeshComponent>();
+
+	if (!World || !TemplateMeshComponent) return 0;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* InstancesActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (!InstancesActor) return 0;
+
+	UHierarchicalInstancedStaticMeshComponent* InstancesComponent =
+		NewObject<UHierarchicalInstancedStaticMeshComponent>(InstancesActor, NAME_None, RF_Transactional);
+
+	InstancesComponent->SetMobility(EComponentMobility::Static);
+	InstancesComponent->SetStaticMesh(TemplateMeshComponent->GetStaticMesh());
+
+	for (int32 MaterialIndex = 0; MaterialIndex < TemplateMeshComponent->GetNumMaterials(); MaterialIndex++)
+	{
+		InstancesComponent->SetMaterial(MaterialIndex, TemplateMeshComponent->GetMaterial(MaterialIndex));
+	}
+
+	InstancesActor->SetRootComponent(InstancesComponent);
+	InstancesActor->AddInstanceComponent(InstancesComponent);
+	InstancesComponent->RegisterComponent();
+
+	//One batched add, the tree is built once for all instances.
+	InstancesComponent->AddInstances(ScatterTransforms, false, true);
+
+	InstancesActor->SetActorLabel(TemplateActor->GetActorLabel() + TEXT("_Scatter"));
+
+	return InstancesComponent->GetInstanceCount();
+
+}//SpawnScatteredInstances.
+
+#pragma endregion
+
+#pragma region DropToSurfaceCore
+
+void UQuickActorActionsWidget::OnDropTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceData)
+{
+	if (!PendingDropTraces.IsValidIndex(TraceData.UserData)) return;
+
+	FPendingDropTrace& PendingTrace = PendingDropTraces[TraceData.UserData];
+	if (PendingTrace.bCompleted) return;
+
+	PendingTrace.bCompleted = true;
+	NumOfDropTracesCompleted++;
+
+	for (const FHitResult& Hit : TraceData.OutHits)
+	{
+		if (Hit.bBlockingHit)
+		{
+			PendingTrace.bHit = true;
+			PendingTrace.ImpactPoint = Hit.ImpactPoint;
+			PendingTrace.ImpactNormal = Hit.ImpactNormal;
+			break;
+		}
+	}
+
+}//OnDropTraceCompleted.
+
+bool UQuickActorActionsWidget::TickPendingDropTraces(float DeltaTime)
+{
+	UWorld* World = DropTraceWorld.Get();
+	int32 NumOfSynchronousTraces = 0;
+
+	if (World && NumOfDropTracesCompleted < PendingDropTraces.Num())
+	{
+		if (++NumOfDropTraceFramesWaited < MaxDropTraceFramesToWait) return true;
+
+		//The trace pipeline isn't being pumped for this world, finish whatever is left in place.
+		for (FPendingDropTrace& PendingTrace : PendingDropTraces)
+		{
+			if (PendingTrace.bCompleted) continue;
+
+			FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SuperManagerDropToSurface), true, PendingTrace.Actor.Get());
+			FHitResult Hit;
+
+			PendingTrace.bCompleted = true;
+			PendingTrace.bHit = World->LineTraceSingleByChannel(Hit, PendingTrace.TraceStart, PendingTrace.TraceEnd,
+				DropTraceChannel, QueryParams);
+			PendingTrace.ImpactPoint = Hit.ImpactPoint;
+			PendingTrace.ImpactNormal = Hit.ImpactNormal;
+
+			NumOfSynchronousTraces++;
+		}
+	}
+
+	ApplyDropTraceResults(NumOfSynchronousTraces);
+
+	DropTraceTickerHandle.Reset();
+	return false;
+
+}//TickPendingDropTraces.
+
+void UQuickActorActionsWidget::ApplyDropTraceResults(int32 NumOfSynchronousTraces)
+{
+	const double TraceSeconds = FPlatformTime::Seconds() - DropTraceStartTime;
+	const int32 NumOfTraces = PendingDropTraces.Num();
+	uint32 Counter = 0;
+
+	{
+		const FScopedTransaction Transaction(FText::FromString(TEXT("Drop Actors To Surface")));
+
+		for (const FPendingDropTrace& PendingTrace : PendingDropTraces)
+		{
+			AActor* ActorToDrop = PendingTrace.Actor.Get();
+
+			if (!ActorToDrop || !PendingTrace.bHit) continue;
+
+			FTransform DroppedTransform = ActorToDrop->GetActorTransform();
+			DroppedTransform.SetTranslation(PendingTrace.ImpactPoint + FVector(0.f, 0.f, PendingTrace.PivotHeight));
+
+			if (bAlignToSurfaceNormal)
+			{
+				DroppedTransform.SetRotation(
+					FRotationMatrix::MakeFromZX(PendingTrace.ImpactNormal, ActorToDrop->GetActorForwardVector()).ToQuat());
+			}
+
+			ActorToDrop->Modify();
+			ActorToDrop->SetActorTransform(DroppedTransform);
+
+			Counter++;
+		}
+	}
+
+	PendingDropTraces.Empty();
+	DropTraceDelegate.Unbind();
+
+	const double TracesPerSecond = TraceSeconds > 0.0 ? NumOfTraces / TraceSeconds : 0.0;
+
+	DebugHeader::ShowNotifyInfo(FString::Printf(TEXT("Dropped %u of %d actors to surface\n%d traces in %.1f ms (%.0f traces/s, %d synchronous)"),
+		Counter, NumOfTraces, NumOfTraces, TraceSeconds * 1000.0, TracesPerSecond, NumOfSynchronousTraces));
+
+}//ApplyDropTraceResults.
+
+#pragma endregion
+
+#pragma region DuplicateActorAuditCore
+
+void UQuickActorActionsWidget::FindOverlappingDuplicates(TArray<TArray<AActor*>>& OutDuplicateGroups)
+{
+	TArray<AActor*> AllLevelActors = EditorActorSubsystem->GetAllLevelActors();
+
+	const double LocationStep = FMath::Max(DuplicateLocationTolerance, UE_KINDA_SMALL_NUMBER);
+	const double RotationTolerance = FMath::DegreesToRadians(FMath::Max(DuplicateRotationTolerance, UE_KINDA_SMALL_NUMBER));
+	const double ScaleTolerance = FMath::Max(DuplicateScaleTolerance, UE_KINDA_SMALL_NUMBER);
+
+	//Cells are one location tolerance wide, so a match is always in the actor's own cell or a neighbouring one.
+	auto GetCell = [LocationStep](const FVector& Location)
+	{
+		return FIntVector(
+			FMath::FloorToInt32(Location.X / LocationStep),
+			FMath::FloorToInt32(Location.Y / LocationStep),
+			FMath::FloorToInt32(Location.Z / LocationStep));
+	};
+
+	//Groups starting in each cell, compared against the first actor of each group.
+	TMap<FDuplicateActorKey, TArray<int32>> GroupsByKey;
+	GroupsByKey.Reserve(AllLevelActors.Num());
+
+	TArray<TArray<AActor*>> ActorsByKey;
+	TArray<FTransform> GroupTransforms;
+
+	for (AActor* ActorInLevel : AllLevelActors)
+	{
+		if (!ActorInLevel) continue;
+
+		//Only actors that draw something can double draw calls.
+		if (!ActorInLevel->FindComponentByClass<UPrimitiveComponent>()) continue;
+
+		const UStaticMeshComponent* MeshComponent = ActorInLevel->FindComponentByClass<UStaticMeshComponent>();
+		const UObject* StaticMesh = MeshComponent ? MeshComponent->GetStaticMesh() : nullptr;
+
+		const FTransform ActorTransform = ActorInLevel->GetActorTransform();
+
+		FDuplicateActorKey Key;
+		Key.MeshOrClass = StaticMesh ? StaticMesh : ActorInLevel->GetClass();
+		Key.ActorClass = ActorInLevel->GetClass();
+
+		const FIntVector ActorCell = GetCell(ActorTransform.GetLocation());
+		int32 MatchingGroup = INDEX_NONE;
+
+		for (int32 OffsetZ = -1; OffsetZ <= 1 && MatchingGroup == INDEX_NONE; OffsetZ++)
+		{
+			for (int32 OffsetY = -1; OffsetY <= 1 && MatchingGroup == INDEX_NONE; OffsetY++)
+			{
+				for (int32 OffsetX = -1; OffsetX <= 1 && MatchingGroup == INDEX_NONE; OffsetX++)
+				{
+					Key.Cell = ActorCell + FIntVector(OffsetX, OffsetY, OffsetZ);
+
+					const TArray<int32>* GroupsInCell = GroupsByKey.Find(Key);
+					if (!GroupsInCell) continue;
+
+					for (const int32 GroupIndex : *GroupsInCell)
+					{
+						const FTransform& GroupTransform = GroupTransforms[GroupIndex];
+
+						//Quaternions compare orientations, so 0 and 360 degrees or other equivalent rotators match.
+						if (FMath::Abs(GroupTransform.GetLocation().X - ActorTransform.GetLocation().X) <= LocationStep &&
+							FMath::Abs(GroupTransform.GetLocation().Y - ActorTransform.GetLocation().Y) <= LocationStep &&
+							FMath::Abs(GroupTransform.GetLocation().Z - ActorTransform.GetLocation().Z) <= LocationStep &&
+							GroupTransform.GetRotation().AngularDistance(ActorTransform.GetRotation()) <= RotationTolerance &&
+							GroupTransform.GetScale3D().Equals(ActorTransform.GetScale3D(), ScaleTolerance))
+						{
+							MatchingGroup = GroupIndex;
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		if (MatchingGroup != INDEX_NONE)
+		{
+			ActorsByKey[MatchingGroup].Add(ActorInLevel);
+		}
+		else
+		{
+			Key.Cell = ActorCell;
+			GroupsByKey.FindOrAdd(Key).Add(ActorsByKey.Num());
+			ActorsByKey.AddDefaulted_GetRef().Add(ActorInLevel);
+			GroupTransforms.Add(ActorTransform);
+		}
+	}
+
+	for (TArray<AActor*>& ActorsWithSameKey : ActorsByKey)
+	{
+		if (ActorsWithSameKey.Num() > 1)
+		{
+			OutDuplicateGroups.Add(MoveTemp(ActorsWithSameKey));
+		}
+	}
+
+}//FindOverlappingDuplicates.
+
+void UQuickActorActionsWidget::GetExtraDuplicateCopies(const TArray<TArray<AActor*>>& DuplicateGroups, TArray<AActor*>& OutExtraCopies)
+{
+	for (const TArray<AActor*>& DuplicateGroup : DuplicateGroups)
+	{
+		for (int32 ActorIndex = 1; ActorIndex < DuplicateGroup.Num(); ActorIndex++)
+		{
+			OutExtraCopies.Add(DuplicateGroup[ActorIndex]);
+		}
+	}
+
+}//GetExtraDuplicateCopies.
+
+#pragma endregion
 
 
 bool UQuickActorActionsWidget::GetEditorActorSubsystem()
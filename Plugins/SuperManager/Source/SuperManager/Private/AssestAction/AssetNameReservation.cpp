@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/AssetNameReservation.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+bool FAssetNameReservation::IsNameUsed(const FString& PackagePath, const FString& AssetName)
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> AssetsInPackage;
+	AssetRegistry.GetAssetsByPackageName(FName(*(PackagePath / AssetName)), AssetsInPackage, false);
+
+	return AssetsInPackage.Num() > 0;
+
+}//IsNameUsed.
+
+bool FAssetNameReservation::Reserve(const FString& PackagePath, const FString& AssetName)
+{
+	bool bAlreadyUsed = false;
+	GetUsedNames(PackagePath).Add(FName(*AssetName), &bAlreadyUsed);
+
+	return !bAlreadyUsed;
+
+}//Reserve.
+
+FString FAssetNameReservation::ReserveUnique(const FString& PackagePath, const FString& BaseName)
+{
+	TSet<FName>& UsedNames = GetUsedNames(PackagePath);
+
+	FString CandidateName = BaseName;
+
+	if (UsedNames.Contains(FName(*CandidateName)))
+	{
+		int32& NextSuffix = NextSuffixByBaseName.FindOrAdd(PackagePath / BaseName, 1);
+
+		do
+		{
+			CandidateName = BaseName + TEXT("_") + FString::FromInt(NextSuffix++);
+		}
+		while (UsedNames.Contains(FName(*CandidateName)));
+	}
+
+	UsedNames.Add(FName(*CandidateName));
+	return CandidateName;
+
+}//ReserveUnique.
+
+TSet<FName>& FAssetNameReservation::GetUsedNames(const FString& PackagePath)
+{
+	const FName FolderKey(*PackagePath);
+
+	if (TSet<FName>* FoundNames = UsedNamesByFolder.Find(FolderKey))
+	{
+		return *FoundNames;
+	}
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> AssetsInFolder;
+	AssetRegistry.GetAssetsByPath(FolderKey, AssetsInFolder, false);
+
+	TSet<FName>& UsedNames = UsedNamesByFolder.Add(FolderKey);
+	UsedNames.Reserve(AssetsInFolder.Num());
+
+	for (const FAssetData& AssetData : AssetsInFolder)
+	{
+		UsedNames.Add(AssetData.AssetName);
+	}
+
+	return UsedNames;
+
+}//GetUsedNames.
@@ -0,0 +1,263 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/AssetPrefixRules.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "Engine/Blueprint.h"
+#include "Materials/MaterialInstance.h"
+#include "Misc/PackageName.h"
+#include "CustomSettings/SuperManagerSettings.h"
+#include "Async/ParallelFor.h"
+#include "DebugHeader.h"
+
+FAssetPrefixRules::FAssetPrefixRules()
+{
+	//Soft class paths, so classes from unloaded plugins can be listed without loading them.
+	for (const TPair<TSoftClassPtr<UObject>, FString>& Prefix : GetDefault<USuperManagerSettings>()->AssetPrefixes)
+	{
+		const FTopLevelAssetPath ClassPath = Prefix.Key.ToSoftObjectPath().GetAssetPath();
+
+		if (!ClassPath.IsValid() || Prefix.Value.IsEmpty()) continue;
+
+		PrefixByClassPath.Add(ClassPath, Prefix.Value);
+	}
+
+}//FAssetPrefixRules.
+
+const FString* FAssetPrefixRules::ResolvePrefix(const FTopLevelAssetPath& ClassPath)
+{
+	if (const FString* const* FoundPrefix = ResolvedPrefixes.Find(ClassPath))
+	{
+		return *FoundPrefix;
+	}
+
+	const FString* ResolvedPrefix = PrefixByClassPath.Find(ClassPath);
+
+	if (!ResolvedPrefix)
+	{
+		IAssetRegistry& AssetRegistry =
+			FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+		//Nearest ancestor first.
+		TArray<FTopLevelAssetPath> AncestorClassPaths;
+		AssetRegistry.GetAncestorClassNames(ClassPath, AncestorClassPaths);
+
+		for (const FTopLevelAssetPath& AncestorClassPath : AncestorClassPaths)
+		{
+			ResolvedPrefix = PrefixByClassPath.Find(AncestorClassPath);
+
+			if (ResolvedPrefix) break;
+		}
+	}
+
+	ResolvedPrefixes.Add(ClassPath, ResolvedPrefix);
+	return ResolvedPrefix;
+
+}//ResolvePrefix.
+
+const FString* FAssetPrefixRules::ResolvePrefix(const FAssetData& AssetData)
+{
+	//A widget blueprint's parent is a UserWidget, which is a better match than Blueprint itself.
+	const FTopLevelAssetPath ParentClassPath = GetParentClassPath(AssetData);
+
+	if (ParentClassPath.IsValid())
+	{
+		if (const FString* ParentPrefix = ResolvePrefix(ParentClassPath))
+		{
+			return ParentPrefix;
+		}
+	}
+
+	return ResolvePrefix(AssetData.AssetClassPath);
+
+}//ResolvePrefix.
+
+FTopLevelAssetPath FAssetPrefixRules::GetParentClassPath(const FAssetData& AssetData)
+{
+	FString ParentClassExportPath;
+	if (!AssetData.GetTagValue(FBlueprintTags::ParentClassPath, ParentClassExportPath)) return FTopLevelAssetPath();
+
+	return FTopLevelAssetPath(FPackageName::ExportTextPathToObjectPath(ParentClassExportPath));
+
+}//GetParentClassPath.
+
+bool FAssetPrefixRules::MakePrefixedName(const FAssetData& AssetData, FString& OutNewName)
+{
+	const FString* PrefixFound = ResolvePrefix(AssetData);
+
+	if (!PrefixFound)
+	{
+		DebugHeader::Print(TEXT("Failed to find prefix for class ") + AssetData.AssetClassPath.GetAssetName().ToString(), FColor::Red);
+		return false;
+	}
+
+	const FString OldName = AssetData.AssetName.ToString();
+	if (OldName.StartsWith(*PrefixFound))
+	{
+		DebugHeader::Print(OldName + TEXT(" already has prefix added"), FColor::Red);
+		return false;
+	}
+
+	OutNewName = ApplyPrefix(AssetData, *PrefixFound);
+	return true;
+
+}//MakePrefixedName.
+
+FString FAssetPrefixRules::ApplyPrefix(const FAssetData& AssetData, const FString& Prefix)
+{
+	FString OldName = AssetData.AssetName.ToString();
+
+	if (AssetData.IsInstanceOf(UMaterialInstance::StaticClass()))
+	{
+		OldName.RemoveFromStart(TEXT("M_"));
+		OldName.RemoveFromEnd(TEXT("_Inst"));
+	}
+
+	return Prefix + OldName;
+
+}//ApplyPrefix.
+
+TArray<int32> FAssetPrefixRules::FindNamingViolations(const TArray<FAssetData>& AssetsData, TArray<const FString*>& OutPrefixes)
+{
+	OutPrefixes.SetNumUninitialized(AssetsData.Num());
+
+	const int32 NumOfShards = FMath::Clamp(AssetsData.Num() / 4096, 1, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	const int32 AssetsPerShard = FMath::DivideAndRoundUp(AssetsData.Num(), NumOfShards);
+
+	//Parent class tags are parsed in the shards, each shard also lists the distinct classes it saw.
+	TArray<FTopLevelAssetPath> ParentClassPaths;
+	ParentClassPaths.SetNum(AssetsData.Num());
+
+	TArray<TSet<FTopLevelAssetPath>> ClassPathsPerShard;
+	ClassPathsPerShard.SetNum(NumOfShards);
+
+	ParallelFor(NumOfShards, [&](int32 ShardIndex)
+	{
+		const int32 ShardStart = ShardIndex * AssetsPerShard;
+		const int32 ShardEnd = FMath::Min(ShardStart + AssetsPerShard, AssetsData.Num());
+
+		TSet<FTopLevelAssetPath>& ShardClassPaths = ClassPathsPerShard[ShardIndex];
+
+		for (int32 AssetIndex = ShardStart; AssetIndex < ShardEnd; AssetIndex++)
+		{
+			ShardClassPaths.Add(AssetsData[AssetIndex].AssetClassPath);
+
+			ParentClassPaths[AssetIndex] = GetParentClassPath(AssetsData[AssetIndex]);
+
+			if (ParentClassPaths[AssetIndex].IsValid())
+			{
+				ShardClassPaths.Add(ParentClassPaths[AssetIndex]);
+			}
+		}
+	});
+
+	//Registry lookups and the cache stay on this thread, once per distinct class, a few hundred cover a whole project.
+	for (const TSet<FTopLevelAssetPath>& ShardClassPaths : ClassPathsPerShard)
+	{
+		for (const FTopLevelAssetPath& ClassPath : ShardClassPaths)
+		{
+			ResolvePrefix(ClassPath);
+		}
+	}
+
+	//Each shard keeps its own list, merged in shard order so the result matches the input order.
+	TArray<TArray<int32>> ViolationsPerShard;
+	ViolationsPerShard.SetNum(NumOfShards);
+
+	const TMap<FTopLevelAssetPath, const FString*>& ReadOnlyPrefixes = ResolvedPrefixes;
+
+	ParallelFor(NumOfShards, [&](int32 ShardIndex)
+	{
+		const int32 ShardStart = ShardIndex * AssetsPerShard;
+		const int32 ShardEnd = FMath::Min(ShardStart + AssetsPerShard, AssetsData.Num());
+
+		TArray<int32>& ShardViolations = ViolationsPerShard[ShardIndex];
+		TStringBuilder<FName::StringBufferSize> AssetName;
+
+		for (int32 AssetIndex = ShardStart; AssetIndex < ShardEnd; AssetIndex++)
+		{
+			//Same order as ResolvePrefix, the parent class wins when it has a prefix.
+			const FString* Prefix = ParentClassPaths[AssetIndex].IsValid() ? ReadOnlyPrefixes.FindChecked(ParentClassPaths[AssetIndex]) : nullptr;
+
+			if (!Prefix)
+			{
+				Prefix = ReadOnlyPrefixes.FindChecked(AssetsData[AssetIndex].AssetClassPath);
+			}
+
+			OutPrefixes[AssetIndex] = Prefix;
+			if (!Prefix) continue;
+
+			AssetName.Reset();
+			AssetsData[AssetIndex].AssetName.AppendString(AssetName);
+
+			if (!FStringView(AssetName).StartsWith(*Prefix, ESearchCase::IgnoreCase))
+			{
+				ShardViolations.Add(AssetIndex);
+			}
+		}
+	});
+
+	TArray<int32> ViolationIndices;
+	for (TArray<int32>& ShardViolations : ViolationsPerShard)
+	{
+		ViolationIndices.Append(MoveTemp(ShardViolations));
+	}
+
+	return ViolationIndices;
+
+}//FindNamingViolations.
+
+int32 FAssetPrefixRules::RenameAssets(const TArray<FAssetData>& AssetsToRename, const TArray<FString>& NewNames)
+{
+	check(AssetsToRename.Num() == NewNames.Num());
+
+	TArray<FAssetRenameData> AssetsRenameData;
+	AssetsRenameData.Reserve(AssetsToRename.Num());
+
+	TArray<FSoftObjectPath> NewObjectPaths;
+	NewObjectPaths.Reserve(AssetsToRename.Num());
+
+	for (int32 AssetIndex = 0; AssetIndex < AssetsToRename.Num(); AssetIndex++)
+	{
+		const FAssetData& AssetData = AssetsToRename[AssetIndex];
+		const FString& NewName = NewNames[AssetIndex];
+
+		AssetsRenameData.Emplace(AssetData.GetSoftObjectPath(), AssetData.PackagePath.ToString(), NewName);
+		NewObjectPaths.Emplace(AssetData.PackagePath.ToString() / NewName + TEXT(".") + NewName);
+	}
+
+	if (AssetsRenameData.Num() == 0) return 0;
+
+	IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools")).Get();
+
+	if (!AssetTools.RenameAssets(AssetsRenameData))
+	{
+		DebugHeader::PrintLog(TEXT("Some assets could not be renamed, see the message log for details"));
+	}
+
+	//The renamed assets leave redirectors at their old paths, fix up just those instead of rescanning /Game.
+	TArray<UObjectRedirector*> Redirectors;
+	int32 NumOfRenamedAssets = 0;
+
+	for (int32 AssetIndex = 0; AssetIndex < AssetsRenameData.Num(); AssetIndex++)
+	{
+		if (UObjectRedirector* Redirector = Cast<UObjectRedirector>(AssetsRenameData[AssetIndex].OldObjectPath.ResolveObject()))
+		{
+			Redirectors.Add(Redirector);
+		}
+
+		if (NewObjectPaths[AssetIndex].ResolveObject())
+		{
+			++NumOfRenamedAssets;
+		}
+	}
+
+	if (Redirectors.Num() > 0)
+	{
+		AssetTools.FixupReferencers(Redirectors);
+	}
+
+	return NumOfRenamedAssets;
+
+}//RenameAssets.
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/AssetRowTable.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+void FAssetRowTable::Reserve(int32 NumOfRows)
+{
+	PackageNames.Reserve(NumOfRows);
+	AssetNames.Reserve(NumOfRows);
+	ClassIndices.Reserve(NumOfRows);
+	Flags.Reserve(NumOfRows);
+	RowByPackageName.Reserve(NumOfRows);
+
+}//Reserve.
+
+int32 FAssetRowTable::AddRow(const FAssetData& AssetData)
+{
+	int32* FoundClassIndex = ClassIndexByPath.Find(AssetData.AssetClassPath);
+	const int32 ClassIndex = FoundClassIndex ? *FoundClassIndex : ClassIndexByPath.Add(AssetData.AssetClassPath, ClassPaths.Add(AssetData.AssetClassPath));
+
+	const int32 NewRow = PackageNames.Add(AssetData.PackageName);
+	AssetNames.Add(AssetData.AssetName);
+	ClassIndices.Add(ClassIndex);
+	Flags.Add(EAssetRowFlags::None);
+	RowByPackageName.Add(AssetData.PackageName, NewRow);
+
+	return NewRow;
+
+}//AddRow.
+
+FAssetData FAssetRowTable::GetAssetData(int32 Row) const
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	return AssetRegistry.GetAssetByObjectPath(GetObjectPath(Row));
+
+}//GetAssetData.
+
+int32 FAssetRowTable::FindRow(FName PackageName) const
+{
+	const int32* FoundRow = RowByPackageName.Find(PackageName);
+	return FoundRow ? *FoundRow : INDEX_NONE;
+
+}//FindRow.
+
+void FAssetRowTable::GetLiveRows(TArray<int32>& OutRows) const
+{
+	OutRows.Reset(Num());
+
+	for (int32 Row = 0; Row < Num(); Row++)
+	{
+		if (!HasFlags(Row, EAssetRowFlags::Deleted))
+		{
+			OutRows.Add(Row);
+		}
+	}
+
+}//GetLiveRows.
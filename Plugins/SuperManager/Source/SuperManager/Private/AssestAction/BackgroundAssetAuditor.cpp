@@ -0,0 +1,377 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/BackgroundAssetAuditor.h"
+#include "AssestAction/AssetPrefixRules.h"
+#include "CustomSettings/SuperManagerSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Editor.h"
+#include "Misc/PackageName.h"
+
+static const FString AuditRootFolder(TEXT("/Game"));
+
+FBackgroundAssetAuditor::FBackgroundAssetAuditor()
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FBackgroundAssetAuditor::OnAssetChanged);
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FBackgroundAssetAuditor::OnAssetChanged);
+	AssetRegistry.OnAssetUpdated().AddRaw(this, &FBackgroundAssetAuditor::OnAssetChanged);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FBackgroundAssetAuditor::OnAssetRenamed);
+	AssetRegistry.OnPathAdded().AddRaw(this, &FBackgroundAssetAuditor::OnPathChanged);
+	AssetRegistry.OnPathRemoved().AddRaw(this, &FBackgroundAssetAuditor::OnPathChanged);
+
+	GetMutableDefault<USuperManagerSettings>()->OnSettingChanged().AddRaw(this, &FBackgroundAssetAuditor::OnSettingsChanged);
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBackgroundAssetAuditor::Tick));
+
+}//FBackgroundAssetAuditor.
+
+FBackgroundAssetAuditor::~FBackgroundAssetAuditor()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetUpdated().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+		AssetRegistry.OnPathAdded().RemoveAll(this);
+		AssetRegistry.OnPathRemoved().RemoveAll(this);
+	}
+
+	if (UObjectInitialized())
+	{
+		GetMutableDefault<USuperManagerSettings>()->OnSettingChanged().RemoveAll(this);
+	}
+
+}//~FBackgroundAssetAuditor.
+
+bool FBackgroundAssetAuditor::Tick(float DeltaTime)
+{
+	const USuperManagerSettings* Settings = GetDefault<USuperManagerSettings>();
+
+	//Stays registered while disabled, so the setting can be toggled without restarting the editor.
+	if (!Settings->bEnableBackgroundAudit) return true;
+
+	//Only idle editor time, never while playing or during another long task.
+	if (GIsSlowTask || (GEditor && GEditor->PlayWorld)) return true;
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	if (AssetRegistry.IsLoadingAssets()) return true;
+
+	//A new prefix table invalidates every naming result, that one restarts even a running pass.
+	if (bNeedsFullPass)
+	{
+		StartPass();
+	}
+	else if (Phase == EAuditPhase::Idle && ChangedFolders.Num() > 0)
+	{
+		StartUpdatePass();
+	}
+
+	if (Phase == EAuditPhase::Idle) return true;
+
+	const double Deadline = FPlatformTime::Seconds() + Settings->BackgroundAuditBudgetMs / 1000.0;
+
+	while (FPlatformTime::Seconds() < Deadline)
+	{
+		if (NextAssetIndex < CurrentFolderAssets.Num())
+		{
+			AuditAsset(CurrentFolderAssets[NextAssetIndex++]);
+			continue;
+		}
+
+		if (NextFolderIndex >= FoldersToScan.Num())
+		{
+			FinishPass();
+			break;
+		}
+
+		//Copied, listing sub paths appends to FoldersToScan.
+		const FString FolderPath = FoldersToScan[NextFolderIndex];
+
+		//Child folders and assets are listed in separate steps, so the deadline is checked between the two registry calls.
+		if (Phase == EAuditPhase::ScanFolders && !bSubPathsListed)
+		{
+			AssetRegistry.GetSubPaths(FolderPath, FoldersToScan, false);
+			bSubPathsListed = true;
+			continue;
+		}
+
+		NextFolderIndex++;
+		bSubPathsListed = false;
+
+		CurrentFolderAssets.Reset();
+		NextAssetIndex = 0;
+		AssetRegistry.GetAssetsByPath(FName(*FolderPath), CurrentFolderAssets, false);
+
+		if (CurrentFolderAssets.Num() == 0) continue;
+
+		//A folder with assets keeps every folder above it from being empty. Update passes recheck emptiness when they finish.
+		FString NonEmptyPath = Phase == EAuditPhase::ScanFolders ? FolderPath : FString();
+		while (!NonEmptyPath.IsEmpty())
+		{
+			bool bAlreadyMarked = false;
+			NonEmptyFolders.Add(NonEmptyPath, &bAlreadyMarked);
+
+			if (bAlreadyMarked) break;
+
+			NonEmptyPath = FPaths::GetPath(NonEmptyPath);
+		}
+
+		//Excluded folders only count towards emptiness, their assets are not audited.
+		if (IsExcludedPath(FolderPath))
+		{
+			CurrentFolderAssets.Reset();
+		}
+	}
+
+	return true;
+
+}//Tick.
+
+void FBackgroundAssetAuditor::StartPass()
+{
+	bNeedsFullPass = false;
+	Phase = EAuditPhase::ScanFolders;
+
+	//The full pass sees every change made so far.
+	ChangedPackages.Reset();
+	ChangedFolders.Reset();
+
+	WorkingResults = FAuditResults();
+	NonEmptyFolders.Reset();
+	CurrentFolderAssets.Reset();
+	NextAssetIndex = 0;
+	NextFolderIndex = 0;
+	bSubPathsListed = false;
+
+	//Rebuilt every pass, the prefix table may have been edited.
+	PrefixRules = MakeUnique<FAssetPrefixRules>();
+
+	//Only the root, Tick lists the folders below it one level at a time.
+	FoldersToScan.Reset();
+	FoldersToScan.Add(AuditRootFolder);
+
+}//StartPass.
+
+void FBackgroundAssetAuditor::StartUpdatePass()
+{
+	Phase = EAuditPhase::UpdateFolders;
+
+	WorkingResults = PublishedResults;
+	CurrentFolderAssets.Reset();
+	NextAssetIndex = 0;
+	NextFolderIndex = 0;
+	bSubPathsListed = false;
+
+	PrefixRules = MakeUnique<FAssetPrefixRules>();
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	//A changed asset can make what it references used, so the folders of its dependencies are audited again too.
+	//A reference that was dropped is not followed, the asset it pointed at stays listed as used until the next full pass.
+	TSet<FString> FoldersToUpdate = MoveTemp(ChangedFolders);
+	ChangedFolders.Reset();
+
+	TArray<FName> Dependencies;
+	for (const FName& ChangedPackage : ChangedPackages)
+	{
+		Dependencies.Reset();
+		AssetRegistry.GetDependencies(ChangedPackage, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+
+		for (const FName& Dependency : Dependencies)
+		{
+			FoldersToUpdate.Add(FPackageName::GetLongPackagePath(Dependency.ToString()));
+		}
+	}
+
+	ChangedPackages.Reset();
+
+	FoldersToScan.Reset();
+	for (const FString& FolderPath : FoldersToUpdate)
+	{
+		if (IsUnderFolder(FolderPath, AuditRootFolder))
+		{
+			FoldersToScan.Add(FolderPath);
+		}
+	}
+
+	//Entries of the updated folders are replaced by what the pass finds in them.
+	const TSet<FString> UpdatedFolders(FoldersToScan);
+
+	WorkingResults.UnusedAssets.RemoveAll([&UpdatedFolders](const FAssetData& AssetData)
+		{
+			return UpdatedFolders.Contains(AssetData.PackagePath.ToString());
+		});
+
+	WorkingResults.NamingViolations.RemoveAll([&UpdatedFolders](const FNamingViolation& Violation)
+		{
+			return UpdatedFolders.Contains(Violation.AssetData.PackagePath.ToString());
+		});
+
+}//StartUpdatePass.
+
+void FBackgroundAssetAuditor::AuditAsset(const FAssetData& AssetData)
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	Referencers.Reset();
+	AssetRegistry.GetReferencers(AssetData.PackageName, Referencers, UE::AssetRegistry::EDependencyCategory::Package);
+	Referencers.Remove(AssetData.PackageName);
+
+	if (Referencers.Num() == 0)
+	{
+		WorkingResults.UnusedAssets.Add(AssetData);
+	}
+
+	const FString* Prefix = PrefixRules->ResolvePrefix(AssetData);
+
+	if (Prefix && !AssetData.AssetName.ToString().StartsWith(*Prefix))
+	{
+		WorkingResults.NamingViolations.Add({ AssetData, *Prefix });
+	}
+
+}//AuditAsset.
+
+void FBackgroundAssetAuditor::FinishPass()
+{
+	if (Phase == EAuditPhase::ScanFolders)
+	{
+		for (const FString& FolderPath : FoldersToScan)
+		{
+			if (FolderPath != AuditRootFolder && !IsExcludedPath(FolderPath) && !NonEmptyFolders.Contains(FolderPath))
+			{
+				WorkingResults.EmptyFolders.Add(FolderPath);
+			}
+		}
+	}
+	else
+	{
+		IAssetRegistry& AssetRegistry =
+			FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+		//Emptiness only changes along the updated folders and the folders above them.
+		TSet<FString> FoldersToRecheck;
+		for (const FString& FolderPath : FoldersToScan)
+		{
+			FString RecheckPath = FolderPath;
+			while (IsUnderFolder(RecheckPath, AuditRootFolder))
+			{
+				bool bAlreadyAdded = false;
+				FoldersToRecheck.Add(RecheckPath, &bAlreadyAdded);
+
+				if (bAlreadyAdded) break;
+
+				RecheckPath = FPaths::GetPath(RecheckPath);
+			}
+		}
+
+		for (const FString& FolderPath : FoldersToRecheck)
+		{
+			WorkingResults.EmptyFolders.Remove(FolderPath);
+
+			if (FolderPath != AuditRootFolder && !IsExcludedPath(FolderPath) &&
+				AssetRegistry.PathExists(FolderPath) && !AssetRegistry.HasAssets(FName(*FolderPath), true))
+			{
+				WorkingResults.EmptyFolders.Add(FolderPath);
+			}
+		}
+	}
+
+	PublishedResults = MoveTemp(WorkingResults);
+	WorkingResults = FAuditResults();
+
+	FoldersToScan.Empty();
+	CurrentFolderAssets.Empty();
+	NonEmptyFolders.Empty();
+	PrefixRules.Reset();
+
+	Phase = EAuditPhase::Idle;
+	bHasResults = true;
+
+}//FinishPass.
+
+void FBackgroundAssetAuditor::OnAssetChanged(const FAssetData& AssetData)
+{
+	ChangedPackages.Add(AssetData.PackageName);
+	ChangedFolders.Add(AssetData.PackagePath.ToString());
+
+}//OnAssetChanged.
+
+void FBackgroundAssetAuditor::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	OnAssetChanged(AssetData);
+
+	//The old folder lost an asset.
+	ChangedFolders.Add(FPackageName::GetLongPackagePath(FPackageName::ObjectPathToPackageName(OldObjectPath)));
+
+}//OnAssetRenamed.
+
+void FBackgroundAssetAuditor::OnSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	//Cached violations and their prefixes come from the table the pass started with.
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(USuperManagerSettings, AssetPrefixes))
+	{
+		bNeedsFullPass = true;
+	}
+
+}//OnSettingsChanged.
+
+bool FBackgroundAssetAuditor::CanAnswerFor(const FString& FolderPath) const
+{
+	return IsUpToDate() && IsUnderFolder(FolderPath, AuditRootFolder);
+
+}//CanAnswerFor.
+
+TArray<FAssetData> FBackgroundAssetAuditor::GetUnusedAssetsUnder(const FString& FolderPath) const
+{
+	return PublishedResults.UnusedAssets.FilterByPredicate([&FolderPath](const FAssetData& AssetData)
+		{
+			return IsUnderFolder(AssetData.PackagePath.ToString(), FolderPath);
+		});
+
+}//GetUnusedAssetsUnder.
+
+TArray<FString> FBackgroundAssetAuditor::GetEmptyFoldersUnder(const FString& FolderPath) const
+{
+	return PublishedResults.EmptyFolders.FilterByPredicate([&FolderPath](const FString& EmptyFolder)
+		{
+			return EmptyFolder != FolderPath && IsUnderFolder(EmptyFolder, FolderPath);
+		});
+
+}//GetEmptyFoldersUnder.
+
+TArray<FBackgroundAssetAuditor::FNamingViolation> FBackgroundAssetAuditor::GetNamingViolationsUnder(const FString& FolderPath) const
+{
+	return PublishedResults.NamingViolations.FilterByPredicate([&FolderPath](const FNamingViolation& Violation)
+		{
+			return IsUnderFolder(Violation.AssetData.PackagePath.ToString(), FolderPath);
+		});
+
+}//GetNamingViolationsUnder.
+
+//Same folders the menu actions leave alone.
+bool FBackgroundAssetAuditor::IsExcludedPath(const FString& Path)
+{
+	return Path.Contains(TEXT("Developers")) ||
+		Path.Contains(TEXT("Collections")) ||
+		Path.Contains(TEXT("__ExternalActors__")) ||
+		Path.Contains(TEXT("__ExternalObjects__"));
+
+}//IsExcludedPath.
+
+bool FBackgroundAssetAuditor::IsUnderFolder(const FString& Path, const FString& FolderPath)
+{
+	return Path == FolderPath || Path.StartsWith(FolderPath + TEXT("/"));
+
+}//IsUnderFolder.
@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/MaterialGraphHasher.h"
+#include "Materials/Material.h"
+#include "Engine/Texture.h"
+#include "Materials/MaterialExpressionTextureSample.h"
+#include "Materials/MaterialExpressionTextureSampleParameter.h"
+#include "Materials/MaterialExpressionCustomOutput.h"
+#include "Hash/CityHash.h"
+
+uint64 FMaterialGraphHasher::HashMaterial(UMaterial* Material, TArray<UMaterialExpressionTextureBase*>* OutTextureExpressions)
+{
+	if (!Material) return 0;
+
+	FMaterialGraphHasher Hasher;
+	Hasher.TextureExpressions = OutTextureExpressions;
+
+	//Settings that change the generated shader as much as the graph does.
+	uint64 Hash = HashString(Material->GetClass()->GetName());
+	Hash = Combine(Hash, (uint64)Material->MaterialDomain);
+	Hash = Combine(Hash, (uint64)Material->BlendMode);
+	Hash = Combine(Hash, (uint64)Material->GetShadingModels().GetShadingModelField());
+	Hash = Combine(Hash, (uint64)Material->IsTwoSided());
+	Hash = Combine(Hash, (uint64)Material->bUseMaterialAttributes);
+	Hash = Combine(Hash, (uint64)Material->bTangentSpaceNormal);
+	Hash = Combine(Hash, (uint64)FMath::RoundToInt(Material->OpacityMaskClipValue * 1000.f));
+
+	for (int32 Usage = 0; Usage < MATUSAGE_MAX; Usage++)
+	{
+		Hash = Combine(Hash, (uint64)Material->GetUsageByFlag((EMaterialUsage)Usage));
+	}
+
+	for (int32 PropertyIndex = 0; PropertyIndex < MP_MAX; PropertyIndex++)
+	{
+		const FExpressionInput* PropertyInput = Material->GetExpressionInputForProperty((EMaterialProperty)PropertyIndex);
+
+		if (!PropertyInput || !PropertyInput->Expression) continue;
+
+		Hash = Combine(Hash, (uint64)PropertyIndex);
+		Hash = Combine(Hash, Hasher.HashInput(PropertyInput));
+	}
+
+	//Custom outputs are roots of their own, sorted so their order in the expression list does not matter.
+	TArray<uint64> CustomOutputHashes;
+	for (UMaterialExpression* Expression : Material->GetExpressions())
+	{
+		if (Expression && Expression->IsA<UMaterialExpressionCustomOutput>())
+		{
+			CustomOutputHashes.Add(Hasher.HashExpression(Expression));
+		}
+	}
+	CustomOutputHashes.Sort();
+
+	for (const uint64 CustomOutputHash : CustomOutputHashes)
+	{
+		Hash = Combine(Hash, CustomOutputHash);
+	}
+
+	return Hash;
+
+}//HashMaterial.
+
+uint64 FMaterialGraphHasher::HashInput(const FExpressionInput* Input)
+{
+	if (!Input || !Input->Expression) return 0;
+
+	uint64 Hash = HashExpression(Input->Expression);
+	Hash = Combine(Hash, (uint64)Input->OutputIndex);
+	Hash = Combine(Hash, (uint64)(Input->Mask | Input->MaskR << 1 | Input->MaskG << 2 | Input->MaskB << 3 | Input->MaskA << 4));
+
+	return Hash;
+
+}//HashInput.
+
+uint64 FMaterialGraphHasher::HashExpression(UMaterialExpression* Expression)
+{
+	if (const uint64* FoundHash = ExpressionHashes.Find(Expression))
+	{
+		return *FoundHash;
+	}
+
+	//Placeholder while the node is being walked, graphs are acyclic but a broken asset should not hang the audit.
+	ExpressionHashes.Add(Expression, 1);
+
+	//A texture sample and a texture sample parameter are the same node once textures are ignored.
+	const UClass* HashedClass = Expression->IsA<UMaterialExpressionTextureSampleParameter2D>() ?
+		UMaterialExpressionTextureSample::StaticClass() : Expression->GetClass();
+
+	uint64 Hash = HashString(HashedClass->GetName());
+	Hash = Combine(Hash, HashExpressionProperties(Expression));
+
+	for (FExpressionInputIterator It{ Expression }; It; ++It)
+	{
+		Hash = Combine(Hash, (uint64)It.Index);
+		Hash = Combine(Hash, HashInput(It.Input));
+	}
+
+	//Walk order, inputs first, so the list lines up across materials with the same hash.
+	if (TextureExpressions)
+	{
+		if (UMaterialExpressionTextureBase* TextureExpression = Cast<UMaterialExpressionTextureBase>(Expression))
+		{
+			TextureExpressions->Add(TextureExpression);
+		}
+	}
+
+	ExpressionHashes.Add(Expression, Hash);
+	return Hash;
+
+}//HashExpression.
+
+//Hashes the node's own settings, skipping editor layout, inputs, guids and texture references.
+uint64 FMaterialGraphHasher::HashExpressionProperties(UMaterialExpression* Expression)
+{
+	uint64 Hash = 0;
+
+	for (TFieldIterator<FProperty> PropertyIt(Expression->GetClass()); PropertyIt; ++PropertyIt)
+	{
+		const FProperty* Property = *PropertyIt;
+		const UClass* OwnerClass = Property->GetOwnerClass();
+
+		if (OwnerClass == UMaterialExpression::StaticClass()) continue;
+		if (OwnerClass && OwnerClass->IsChildOf(UMaterialExpressionTextureSampleParameter::StaticClass())) continue;
+		if (Property->HasAnyPropertyFlags(CPF_Transient)) continue;
+
+		if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+		{
+			if (ObjectProperty->PropertyClass->IsChildOf(UTexture::StaticClass())) continue;
+		}
+
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (StructProperty->Struct == TBaseStructure<FGuid>::Get()) continue;
+
+			bool bIsExpressionInput = false;
+			for (const UStruct* Struct = StructProperty->Struct; Struct && !bIsExpressionInput; Struct = Struct->GetSuperStruct())
+			{
+				bIsExpressionInput = Struct->GetFName() == TEXT("ExpressionInput");
+			}
+
+			//Inputs are hashed through the graph walk.
+			if (bIsExpressionInput) continue;
+		}
+
+		FString ValueString;
+		Property->ExportTextItem_InContainer(ValueString, Expression, nullptr, nullptr, PPF_None);
+
+		Hash = Combine(Hash, HashString(Property->GetName()));
+		Hash = Combine(Hash, HashString(ValueString));
+	}
+
+	return Hash;
+
+}//HashExpressionProperties.
+
+uint64 FMaterialGraphHasher::Combine(uint64 Hash, uint64 Value)
+{
+	return CityHash128to64({ Hash, Value });
+
+}//Combine.
+
+uint64 FMaterialGraphHasher::HashString(const FString& String)
+{
+	return CityHash64((const char*)*String, String.Len() * sizeof(TCHAR));
+
+}//HashString.
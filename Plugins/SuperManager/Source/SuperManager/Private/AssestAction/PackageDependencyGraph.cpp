@@ -0,0 +1,347 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/PackageDependencyGraph.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+void FPackageDependencyGraph::Build(const TArray<FName>& RootPackages)
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<int32> NodesToVisit;
+
+	for (const FName& RootPackage : RootPackages)
+	{
+		const int32 NumOfNodesBefore = Num();
+		const int32 RootNode = AddNode(RootPackage);
+
+		if (RootNode >= NumOfNodesBefore) NodesToVisit.Add(RootNode);
+	}
+
+	TArray<FName> PackageDependencies;
+
+	while (NodesToVisit.Num() > 0)
+	{
+		const int32 Node = NodesToVisit.Pop(EAllowShrinking::No);
+
+		PackageDependencies.Reset();
+		AssetRegistry.GetDependencies(PackageNames[Node], PackageDependencies,
+			UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+		TArray<int32> NodeDependencies;
+		NodeDependencies.Reserve(PackageDependencies.Num());
+
+		for (const FName& DependencyName : PackageDependencies)
+		{
+			if (DependencyName.ToString().StartsWith(TEXT("/Script/"))) continue;
+
+			const int32 NumOfNodesBefore = Num();
+			const int32 DependencyNode = AddNode(DependencyName);
+
+			if (DependencyNode >= NumOfNodesBefore) NodesToVisit.Add(DependencyNode);
+			if (DependencyNode != Node) NodeDependencies.AddUnique(DependencyNode);
+		}
+
+		Dependencies[Node] = MoveTemp(NodeDependencies);
+	}
+
+}//Build.
+
+int32 FPackageDependencyGraph::FindNode(FName PackageName) const
+{
+	const int32* FoundNode = NodeByPackageName.Find(PackageName);
+	return FoundNode ? *FoundNode : INDEX_NONE;
+
+}//FindNode.
+
+int32 FPackageDependencyGraph::AddNode(FName PackageName)
+{
+	if (const int32* FoundNode = NodeByPackageName.Find(PackageName))
+	{
+		return *FoundNode;
+	}
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+
+	const int32 NewNode = PackageNames.Add(PackageName);
+	NodeByPackageName.Add(PackageName, NewNode);
+	Dependencies.AddDefaulted();
+	DiskSizes.Add(PackageData.IsSet() ? FMath::Max<int64>(PackageData->DiskSize, 0) : 0);
+
+	return NewNode;
+
+}//AddNode.
+
+int32 FPackageDependencyGraph::ComputeStronglyConnectedComponents(TArray<int32>& OutComponentOfNode, TArray<TArray<int32>>& OutComponents) const
+{
+	OutComponentOfNode.Init(INDEX_NONE, Num());
+	OutComponents.Reset();
+
+	TArray<int32> VisitIndex;
+	TArray<int32> LowLink;
+	VisitIndex.Init(INDEX_NONE, Num());
+	LowLink.Init(INDEX_NONE, Num());
+
+	TBitArray<> IsOnStack(false, Num());
+	TArray<int32> ComponentStack;
+
+	//Explicit call stack, project graphs are deep enough to overflow the real one.
+	struct FVisitFrame
+	{
+		int32 Node;
+		int32 NextDependency;
+	};
+	TArray<FVisitFrame> CallStack;
+
+	int32 NextVisitIndex = 0;
+
+	auto StartVisit = [&](int32 Node)
+		{
+			VisitIndex[Node] = LowLink[Node] = NextVisitIndex++;
+			ComponentStack.Add(Node);
+			IsOnStack[Node] = true;
+			CallStack.Add({ Node, 0 });
+		};
+
+	for (int32 RootNode = 0; RootNode < Num(); RootNode++)
+	{
+		if (VisitIndex[RootNode] != INDEX_NONE) continue;
+
+		StartVisit(RootNode);
+
+		while (CallStack.Num() > 0)
+		{
+			const int32 Node = CallStack.Last().Node;
+			const TArray<int32>& NodeDependencies = Dependencies[Node];
+
+			if (CallStack.Last().NextDependency < NodeDependencies.Num())
+			{
+				const int32 Dependency = NodeDependencies[CallStack.Last().NextDependency++];
+
+				if (VisitIndex[Dependency] == INDEX_NONE)
+				{
+					StartVisit(Dependency);
+				}
+				else if (IsOnStack[Dependency])
+				{
+					LowLink[Node] = FMath::Min(LowLink[Node], VisitIndex[Dependency]);
+				}
+				continue;
+			}
+
+			CallStack.Pop(EAllowShrinking::No);
+
+			if (CallStack.Num() > 0)
+			{
+				const int32 ParentNode = CallStack.Last().Node;
+				LowLink[ParentNode] = FMath::Min(LowLink[ParentNode], LowLink[Node]);
+			}
+
+			if (LowLink[Node] != VisitIndex[Node]) continue;
+
+			//Node is the root of a component, everything above it on the stack belongs to it.
+			const int32 ComponentIndex = OutComponents.Num();
+			TArray<int32>& Component = OutComponents.AddDefaulted_GetRef();
+
+			int32 MemberNode;
+			do
+			{
+				MemberNode = ComponentStack.Pop(EAllowShrinking::No);
+				IsOnStack[MemberNode] = false;
+				OutComponentOfNode[MemberNode] = ComponentIndex;
+				Component.Add(MemberNode);
+			}
+			while (MemberNode != Node);
+		}
+	}
+
+	return OutComponents.Num();
+
+}//ComputeStronglyConnectedComponents.
+
+void FPackageDependencyGraph::GetEdgesWithinComponent(const TArray<int32>& Component, const TArray<int32>& ComponentOfNode, TArray<TPair<int32, int32>>& OutEdges) const
+{
+	OutEdges.Reset();
+
+	for (const int32 MemberNode : Component)
+	{
+		for (const int32 Dependency : Dependencies[MemberNode])
+		{
+			if (ComponentOfNode[Dependency] == ComponentOfNode[MemberNode])
+			{
+				OutEdges.Emplace(MemberNode, Dependency);
+			}
+		}
+	}
+
+}//GetEdgesWithinComponent.
+
+TArray<FPackageDependencyGraph::FClosureSize> FPackageDependencyGraph::ComputeClosureSizes(const TArray<int32>& Nodes) const
+{
+	TArray<int32> ComponentOfNode;
+	TArray<TArray<int32>> Components;
+	const int32 NumOfComponents = ComputeStronglyConnectedComponents(ComponentOfNode, Components);
+
+	//Components each one reaches, itself included, as sparse lists under one shared budget.
+	//Dependencies are finished first so each list is a union of lists already known.
+	constexpr int64 MaxStoredClosureEntries = 1 << 22;
+	int64 NumOfStoredEntries = 0;
+
+	TArray<TArray<int32>> ComponentClosures;
+	ComponentClosures.SetNum(NumOfComponents);
+
+	//Past the budget a component keeps no list, it is walked only if one of Nodes needs it.
+	TBitArray<> IsOverflowed(false, NumOfComponents);
+	TBitArray<> IsSized(false, NumOfComponents);
+
+	TArray<FClosureSize> ComponentSizes;
+	ComponentSizes.SetNum(NumOfComponents);
+
+	//Shared by every union and walk, cleared through the list it built so each pass costs only what it touched.
+	TBitArray<> IsMarked(false, NumOfComponents);
+
+	auto SumClosure = [this, &Components](const TArray<int32>& Closure)
+	{
+		FClosureSize ClosureSize;
+
+		for (const int32 ClosureComponent : Closure)
+		{
+			for (const int32 ClosureNode : Components[ClosureComponent])
+			{
+				ClosureSize.NumPackages++;
+				ClosureSize.DiskBytes += DiskSizes[ClosureNode];
+			}
+		}
+
+		return ClosureSize;
+	};
+
+	for (int32 ComponentIndex = 0; ComponentIndex < NumOfComponents; ComponentIndex++)
+	{
+		if (NumOfStoredEntries >= MaxStoredClosureEntries)
+		{
+			IsOverflowed[ComponentIndex] = true;
+			continue;
+		}
+
+		TArray<int32>& Closure = ComponentClosures[ComponentIndex];
+		Closure.Add(ComponentIndex);
+		IsMarked[ComponentIndex] = true;
+
+		bool bDependsOnOverflowed = false;
+
+		for (int32 MemberIndex = 0; MemberIndex < Components[ComponentIndex].Num() && !bDependsOnOverflowed; MemberIndex++)
+		{
+			for (const int32 Dependency : Dependencies[Components[ComponentIndex][MemberIndex]])
+			{
+				const int32 DependencyComponent = ComponentOfNode[Dependency];
+
+				//Marked means its whole closure is already in.
+				if (IsMarked[DependencyComponent]) continue;
+
+				if (IsOverflowed[DependencyComponent])
+				{
+					bDependsOnOverflowed = true;
+					break;
+				}
+
+				for (const int32 ClosureComponent : ComponentClosures[DependencyComponent])
+				{
+					if (!IsMarked[ClosureComponent])
+					{
+						IsMarked[ClosureComponent] = true;
+						Closure.Add(ClosureComponent);
+					}
+				}
+			}
+		}
+
+		for (const int32 ClosureComponent : Closure)
+		{
+			IsMarked[ClosureComponent] = false;
+		}
+
+		if (bDependsOnOverflowed || NumOfStoredEntries + Closure.Num() > MaxStoredClosureEntries)
+		{
+			Closure.Empty();
+			IsOverflowed[ComponentIndex] = true;
+			continue;
+		}
+
+		NumOfStoredEntries += Closure.Num();
+		ComponentSizes[ComponentIndex] = SumClosure(Closure);
+		IsSized[ComponentIndex] = true;
+	}
+
+	TArray<FClosureSize> ClosureSizes;
+	ClosureSizes.SetNum(Nodes.Num());
+
+	TArray<int32> WalkedClosure;
+	TArray<int32> ComponentsToWalk;
+
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		if (!PackageNames.IsValidIndex(Nodes[NodeIndex])) continue;
+
+		const int32 ComponentIndex = ComponentOfNode[Nodes[NodeIndex]];
+
+		if (!IsSized[ComponentIndex])
+		{
+			//Walks the components past the budget, stored lists below them are taken whole.
+			WalkedClosure.Reset();
+			ComponentsToWalk.Reset();
+
+			IsMarked[ComponentIndex] = true;
+			WalkedClosure.Add(ComponentIndex);
+			ComponentsToWalk.Add(ComponentIndex);
+
+			while (ComponentsToWalk.Num() > 0)
+			{
+				const int32 WalkedComponent = ComponentsToWalk.Pop(EAllowShrinking::No);
+
+				for (const int32 MemberNode : Components[WalkedComponent])
+				{
+					for (const int32 Dependency : Dependencies[MemberNode])
+					{
+						const int32 DependencyComponent = ComponentOfNode[Dependency];
+						if (IsMarked[DependencyComponent]) continue;
+
+						if (IsOverflowed[DependencyComponent])
+						{
+							IsMarked[DependencyComponent] = true;
+							WalkedClosure.Add(DependencyComponent);
+							ComponentsToWalk.Add(DependencyComponent);
+							continue;
+						}
+
+						for (const int32 ClosureComponent : ComponentClosures[DependencyComponent])
+						{
+							if (!IsMarked[ClosureComponent])
+							{
+								IsMarked[ClosureComponent] = true;
+								WalkedClosure.Add(ClosureComponent);
+							}
+						}
+					}
+				}
+			}
+
+			for (const int32 ClosureComponent : WalkedClosure)
+			{
+				IsMarked[ClosureComponent] = false;
+			}
+
+			ComponentSizes[ComponentIndex] = SumClosure(WalkedClosure);
+			IsSized[ComponentIndex] = true;
+		}
+
+		ClosureSizes[NodeIndex] = ComponentSizes[ComponentIndex];
+	}
+
+	return ClosureSizes;
+
+}//ComputeClosureSizes.
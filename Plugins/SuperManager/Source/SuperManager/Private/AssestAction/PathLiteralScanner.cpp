@@ -0,0 +1,174 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/PathLiteralScanner.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <cstring>
+
+namespace PathLiteralScanner
+{
+	static const TCHAR* TextFileExtensions[] = {
+		TEXT("ini"), TEXT("h"), TEXT("hpp"), TEXT("cpp"), TEXT("inl"), TEXT("cs"),
+		TEXT("json"), TEXT("csv"), TEXT("xml"), TEXT("txt"), TEXT("py"), TEXT("uplugin"), TEXT("uproject")
+	};
+
+	static bool IsPathChar(uint8 Char)
+	{
+		return (Char >= 'a' && Char <= 'z') || (Char >= 'A' && Char <= 'Z') || (Char >= '0' && Char <= '9') ||
+			Char == '_' || Char == '-' || Char == '/';
+	}
+}
+
+void FPathLiteralScanner::Scan()
+{
+	ScannedFiles.Reset();
+	FilesByPackage.Reset();
+
+	GatherTextFiles(ScannedFiles);
+
+	//Every project content root is a pattern, all of them start with a slash.
+	TArray<TArray<ANSICHAR>> MountPoints;
+	MountPoints.Emplace("/Game/", 6);
+
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPluginsWithContent())
+	{
+		if (Plugin->GetLoadedFrom() != EPluginLoadedFrom::Project) continue;
+
+		const FString MountedAssetPath = Plugin->GetMountedAssetPath();
+		MountPoints.Emplace(TCHAR_TO_ANSI(*MountedAssetPath), MountedAssetPath.Len());
+	}
+
+	//Each file writes only its own slot, merged once all are done.
+	TArray<TSet<FString>> PackagesPerFile;
+	PackagesPerFile.SetNum(ScannedFiles.Num());
+
+	ParallelFor(ScannedFiles.Num(), [this, &MountPoints, &PackagesPerFile](int32 FileIndex)
+		{
+			const FString& Filename = ScannedFiles[FileIndex];
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+			TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*Filename));
+			TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile.IsValid() && MappedFile->GetFileSize() > 0 ? MappedFile->MapRegion() : nullptr);
+
+			const uint8* Text = MappedRegion.IsValid() ? MappedRegion->GetMappedPtr() : nullptr;
+			int64 TextSize = MappedRegion.IsValid() ? MappedRegion->GetMappedSize() : 0;
+
+			//Read instead where mapping is not supported.
+			TArray<uint8> ReadText;
+			if (!Text)
+			{
+				if (!FFileHelper::LoadFileToArray(ReadText, *Filename, FILEREAD_Silent)) return;
+
+				Text = ReadText.GetData();
+				TextSize = ReadText.Num();
+			}
+
+			//UTF-16 files, mostly inis saved by some editors, are searched as UTF-8 like everything else.
+			if (TextSize >= 2 && ((Text[0] == 0xFF && Text[1] == 0xFE) || (Text[0] == 0xFE && Text[1] == 0xFF)))
+			{
+				FString WideText;
+				if (!FFileHelper::LoadFileToString(WideText, *Filename)) return;
+
+				FTCHARToUTF8 Utf8Text(*WideText);
+				ScanText((const uint8*)Utf8Text.Get(), Utf8Text.Length(), MountPoints, PackagesPerFile[FileIndex]);
+				return;
+			}
+
+			ScanText(Text, TextSize, MountPoints, PackagesPerFile[FileIndex]);
+		});
+
+	for (int32 FileIndex = 0; FileIndex < ScannedFiles.Num(); FileIndex++)
+	{
+		for (const FString& PackageName : PackagesPerFile[FileIndex])
+		{
+			FilesByPackage.FindOrAdd(FName(*PackageName)).Add(FileIndex);
+		}
+	}
+
+}//Scan.
+
+void FPathLiteralScanner::GatherTextFiles(TArray<FString>& OutFiles)
+{
+	TArray<FString> FoldersToScan;
+	FoldersToScan.Add(FPaths::ProjectConfigDir());
+	FoldersToScan.Add(FPaths::GameSourceDir());
+
+	//Content and build output of plugins are not text the plugin wrote.
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetDiscoveredPlugins())
+	{
+		if (Plugin->GetLoadedFrom() != EPluginLoadedFrom::Project) continue;
+
+		FoldersToScan.Add(Plugin->GetBaseDir() / TEXT("Config"));
+		FoldersToScan.Add(Plugin->GetBaseDir() / TEXT("Source"));
+	}
+
+	TArray<FString> FolderFiles;
+
+	for (const FString& Folder : FoldersToScan)
+	{
+		if (!IFileManager::Get().DirectoryExists(*Folder)) continue;
+
+		FolderFiles.Reset();
+		IFileManager::Get().FindFilesRecursive(FolderFiles, *Folder, TEXT("*.*"), true, false);
+
+		for (FString& FilePath : FolderFiles)
+		{
+			const FString Extension = FPaths::GetExtension(FilePath);
+
+			for (const TCHAR* TextFileExtension : PathLiteralScanner::TextFileExtensions)
+			{
+				if (Extension.Equals(TextFileExtension, ESearchCase::IgnoreCase))
+				{
+					OutFiles.Add(MoveTemp(FilePath));
+					break;
+				}
+			}
+		}
+	}
+
+}//GatherTextFiles.
+
+void FPathLiteralScanner::ScanText(const uint8* Text, int64 TextSize, const TArray<TArray<ANSICHAR>>& MountPoints, TSet<FString>& OutPackageNames)
+{
+	const uint8* Cursor = Text;
+	const uint8* TextEnd = Text + TextSize;
+
+	while (Cursor < TextEnd)
+	{
+		//The CRT memchr is vectorised, it skips the long stretches without a slash many bytes at a time.
+		const uint8* Slash = (const uint8*)memchr(Cursor, '/', TextEnd - Cursor);
+		if (!Slash) break;
+
+		Cursor = Slash + 1;
+
+		//A mount point preceded by a path character is the middle of a longer path, like Content/Game/.
+		if (Slash > Text && PathLiteralScanner::IsPathChar(Slash[-1])) continue;
+
+		for (const TArray<ANSICHAR>& MountPoint : MountPoints)
+		{
+			if (TextEnd - Slash < MountPoint.Num() || FMemory::Memcmp(Slash, MountPoint.GetData(), MountPoint.Num()) != 0) continue;
+
+			//The package name ends where the object name or anything that is not a path starts.
+			const uint8* PathEnd = Slash + MountPoint.Num();
+			while (PathEnd < TextEnd && PathLiteralScanner::IsPathChar(*PathEnd)) ++PathEnd;
+
+			const uint8* PackageEnd = PathEnd;
+			while (PackageEnd > Slash + MountPoint.Num() && PackageEnd[-1] == '/') --PackageEnd;
+
+			if (PackageEnd > Slash + MountPoint.Num())
+			{
+				OutPackageNames.Add(FString((int32)(PackageEnd - Slash), (const ANSICHAR*)Slash));
+			}
+
+			Cursor = PathEnd;
+			break;
+		}
+	}
+
+}//ScanText.
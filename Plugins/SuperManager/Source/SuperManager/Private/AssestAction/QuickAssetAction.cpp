@@ -9,6 +9,10 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetToolsModule.h"
 #include "AssetViewUtils.h"
+#include "FileHelpers.h"
+#include "Misc/ScopedSlowTask.h"
+#include "AssestAction/AssetNameReservation.h"
+#include "AssestAction/AssetPrefixRules.h"
 
 
 void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
@@ -22,21 +26,56 @@ void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
 	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
 	uint32 Counter = 0;
 
+	IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools")).Get();
+
+	//Names are picked against the registry up front, so existing _1, _2 ... copies are skipped instead of failing.
+	FAssetNameReservation NameReservation;
+
+	//Every copy is created first and written in one save at the end.
+	TArray<UPackage*> PackagesToSave;
+
+	FScopedSlowTask DuplicateTask((float)(SelectedAssetsData.Num() * NumOfDuplicates + 1),
+		FText::FromString(TEXT("Duplicating assets")));
+	DuplicateTask.MakeDialog(true);
+
 	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
 	{
+		if (DuplicateTask.ShouldCancel()) break;
+
+		UObject* SourceAsset = SelectedAssetData.GetAsset();
+		if (!SourceAsset) continue;
+
+		const FString PackagePath = SelectedAssetData.PackagePath.ToString();
+
 		for (int32 i = 0; i < NumOfDuplicates; i++)
 		{
-			const FString SourceAssetPath = SelectedAssetData.ObjectPath.ToString();
-			const FString NewDuplicateAssetName = SelectedAssetData.AssetName.ToString()+TEXT("_")+FString::FromInt(i+1);
-			const FString NewPathName = FPaths::Combine(SelectedAssetData.PackagePath.ToString(), NewDuplicateAssetName);
+			if (DuplicateTask.ShouldCancel()) break;
+
+			//The source holds the base name, so every copy gets the next free numbered suffix: Rock_1, Rock_2 ...
+			const FString NewDuplicateAssetName =
+				NameReservation.ReserveUnique(PackagePath, SelectedAssetData.AssetName.ToString());
 
-			if (UEditorAssetLibrary::DuplicateAsset(SourceAssetPath, NewPathName))
+			DuplicateTask.EnterProgressFrame(1.f, FText::FromString(NewDuplicateAssetName));
+
+			if (UObject* DuplicatedAsset = AssetTools.DuplicateAsset(NewDuplicateAssetName, PackagePath, SourceAsset))
 			{
-				UEditorAssetLibrary::SaveAsset(NewPathName, false);
+				PackagesToSave.Add(DuplicatedAsset->GetPackage());
 				++Counter;
 			}
+			else
+			{
+				DebugHeader::PrintLog(TEXT("Failed to duplicate ") + SelectedAssetData.AssetName.ToString() + TEXT(" as ") + NewDuplicateAssetName);
+			}
 		}
 	}
+
+	//Copies made before a cancel are kept and saved with the rest.
+	if (PackagesToSave.Num() > 0)
+	{
+		DuplicateTask.EnterProgressFrame(1.f, FText::FromString(FString::Printf(TEXT("Saving %d packages"), PackagesToSave.Num())));
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, false);
+	}
+
 	if (Counter > 0)
 	{
 		//Print(TEXT("Successfully duplicated " + FString::FromInt(Counter) + " files"), FColor::Green);
@@ -47,41 +86,25 @@ void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
 
 void UQuickAssetAction::AddPreFixes()
 {
-	TArray<UObject*> SelectedObjects = UEditorUtilityLibrary::GetSelectedAssets();
-	uint32 Counter = 0;
-
-	for (UObject* SelectedObject : SelectedObjects)
-	{
-		if (!SelectedObject)continue;
-
-		FString* PrefixFound = PrefixMap.Find(SelectedObject->GetClass());
+	//Asset data only, the class path is enough to pick a prefix.
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
 
-		if (!PrefixFound || PrefixFound->IsEmpty())
-		{
-			DebugHeader::Print(TEXT("Failed to find prefix for class")+ SelectedObject->GetClass()->GetName(), FColor::Red);
-			continue;
-		}
+	FAssetPrefixRules PrefixRules;
 
-		FString OldName = SelectedObject->GetName();
-		if (OldName.StartsWith(*PrefixFound))
-		{
-			DebugHeader::Print(OldName + TEXT(" already has prefix added"), FColor::Red);
-			continue;
-		}
-
-		if (SelectedObject->IsA<UMaterialInstance>())
-		{
-			OldName.RemoveFromStart(TEXT("M_"));
-			OldName.RemoveFromEnd(TEXT("_Inst"));
-		}
+	TArray<FAssetData> AssetsToRename;
+	TArray<FString> NewNames;
 
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
+	{
+		FString NewNameWithPrefix;
+		if (!PrefixRules.MakePrefixedName(SelectedAssetData, NewNameWithPrefix)) continue;
 
+		AssetsToRename.Add(SelectedAssetData);
+		NewNames.Add(NewNameWithPrefix);
+	}
 
-		const FString NewNameWithPrefix = *PrefixFound + OldName;
+	const int32 Counter = FAssetPrefixRules::RenameAssets(AssetsToRename, NewNames);
 
-		UEditorUtilityLibrary::RenameAsset(SelectedObject, NewNameWithPrefix);
-		++Counter;
-	}
 	if (Counter > 0)
 	{
 		DebugHeader::ShowNotifyInfo(TEXT("Successfully renamed " + FString::FromInt(Counter) + " assets"));
@@ -1,3 +1,27 @@
+	TArray<UTexture2D*> Textures;
+	TArray<TArray<FColor>> SampleSets;
+	Textures.Reserve(TexturesData.Num());
+
+	const double AnalysisStartTime = FPlatformTime::Seconds();
+
+	{
+		FScopedSlowTask SlowTask(2.f, FText::FromString(TEXT("Reading texture samples")));
+		SlowTask.MakeDialog();
+
+		SlowTask.EnterProgressFrame(1.f, FText::FromString(TEXT("Loading textures")));
+
+		for (const FAssetData& TextureData : TexturesData)
+		{
+			if (UTexture2D* Texture = Cast<UTexture2D>(TextureData.GetAsset()))
+			{
+				Textures.Add(Texture);
+			}
+		}
+
+		SlowTask.EnterProgressFrame(1.f, FText::FromString(FString::Printf(TEXT("Sampling %d textures"), Textures.Num())));
+		FTextureRoleAnalyzer::ReadSampleSets(Textures, SampleSets);
+	}
+
 // Fill out your copyright notice in the Description page of Project Settings.
 
 
@@ -9,6 +33,18 @@
 #include "Factories/MaterialFactoryNew.h"
 #include "Materials/MaterialInstanceConstant.h"
 #include "Factories/MaterialInstanceConstantFactoryNew.h"
+#include "MaterialShared.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/ScopedSlowTask.h"
+#include "FileHelpers.h"
+#include "AssestAction/TextureChannelPacker.h"
+#include "AssestAction/TextureRoleAnalyzer.h"
+#include "AssestAction/AssetNameReservation.h"
+#include "Misc/FileHelper.h"
+#include "AssestAction/MaterialGraphHasher.h"
+#include "Materials/MaterialExpressionTextureSampleParameter2D.h"
+#include "ObjectTools.h"
+#include "UObject/UObjectHash.h"
 
 
 #pragma region QuickMaterialCreationCore
@@ -42,6 +78,11 @@ void UQuickMaterialWidget::CreateMaterialFromSelectedTextures()
 		return;
 	}
 
+	if (ChannelPackingType == E_ChannelPackingType::ECPT_ORM && bPackSeparateMapsToORM)
+	{
+		PackSeparateMapsToORM(SelectedTexturesArray);
+	}
+
 	UMaterial* CreatedMaterial = CreateMaterialAsset(MaterialName, SelectedTextureFolderPath);
 
 	if (!CreatedMaterial)
@@ -50,46 +91,421 @@ void UQuickMaterialWidget::CreateMaterialFromSelectedTextures()
 		return;
 	}
 
-	for (UTexture2D* SelectedTexture : SelectedTexturesArray)
+	const double CompileSeconds = AssembleAndCompileMaterial(CreatedMaterial, SelectedTexturesArray, PinsConnectedCounter);
+
+	if (PinsConnectedCounter > 0)
 	{
-		if (!SelectedTexture) continue;
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully connected ") + 
+			FString::FromInt(PinsConnectedCounter)+ (TEXT(" pins")) +
+			FString::Printf(TEXT("\nCompiled material in %.1f ms"), CompileSeconds * 1000.0));
 
-		switch (ChannelPackingType)
+	}
+
+	if (bCreateMaterialInstance)
+	{
+		CreateMaterialInstanceAsset(CreatedMaterial, MaterialName, SelectedTextureFolderPath);
+	}
+
+	MaterialName = TEXT("M_");
+
+}//CreateMaterialFromSelectedTextures.
+
+
+void UQuickMaterialWidget::CreateMaterialsFromTextureFolder()
+{
+	if (BatchTextureFolder.IsEmpty() || !UEditorAssetLibrary::DoesDirectoryExist(BatchTextureFolder))
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please enter a valid folder"));
+		return;
+	}
+
+	TArray<FTextureSetGroup> TextureSets;
+	GroupTextureSetsUnderFolder(BatchTextureFolder, TextureSets);
+
+	if (TextureSets.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No texture with a supported suffix found under ") + BatchTextureFolder, false);
+		return;
+	}
+
+	const EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
+		FString::FromInt(TextureSets.Num()) + TEXT(" texture sets found.\nWould you like to create a material for each?"), false);
+
+	if (ConfirmResult != EAppReturnType::Yes) return;
+
+	//Each folder is listed once, every set after that is a set lookup.
+	FAssetNameReservation NameReservation;
+	TArray<UPackage*> PackagesToSave;
+	uint32 MaterialsCounter = 0;
+	uint32 InstancesCounter = 0;
+	uint32 SkippedCounter = 0;
+	bool bCancelled = false;
+
+	//Materials are wired first and compiled after the texture settings of the whole job are applied.
+	struct FAssembledMaterial
+	{
+		UMaterial* Material;
+		FString Name;
+		FString PackagePath;
+	};
+	TArray<FAssembledMaterial> AssembledMaterials;
+
+	{
+		FScopedSlowTask SlowTask(TextureSets.Num(), FText::FromString(TEXT("Creating materials from texture sets")));
+		SlowTask.MakeDialog(true);
+
+		for (const FTextureSetGroup& TextureSet : TextureSets)
 		{
-		case E_ChannelPackingType::ECPT_NoChannelPacking:
+			if (SlowTask.ShouldCancel())
+			{
+				bCancelled = true;
+				break;
+			}
+
+			FString NameOfTheMaterial = TextureSet.BaseName;
+			NameOfTheMaterial.RemoveFromStart(TEXT("T_"));
+			NameOfTheMaterial.InsertAt(0, TEXT("M_"));
+
+			SlowTask.EnterProgressFrame(1.f, FText::FromString(NameOfTheMaterial));
+
+			//Existing material means the set was processed by an earlier run.
+			if (!NameReservation.Reserve(TextureSet.PackagePath, NameOfTheMaterial))
+			{
+				SkippedCounter++;
+				continue;
+			}
+
+			//Only the textures of the current set are loaded.
+			TArray<UTexture2D*> TexturesToConnect;
+			for (const FAssetData& TextureData : TextureSet.TexturesData)
+			{
+				if (UTexture2D* Texture = Cast<UTexture2D>(TextureData.GetAsset()))
+				{
+					TexturesToConnect.Add(Texture);
+				}
+			}
+
+			if (ChannelPackingType == E_ChannelPackingType::ECPT_ORM && bPackSeparateMapsToORM)
+			{
+				PackSeparateMapsToORM(TexturesToConnect);
+			}
+
+			UMaterial* CreatedMaterial = CreateMaterialAsset(NameOfTheMaterial, TextureSet.PackagePath);
+			if (!CreatedMaterial) continue;
+
+			uint32 PinsConnectedCounter = 0;
+			AssembleMaterialGraph(CreatedMaterial, TexturesToConnect, PinsConnectedCounter);
+
+			AssembledMaterials.Add({ CreatedMaterial, NameOfTheMaterial, TextureSet.PackagePath });
+			PackagesToSave.Add(CreatedMaterial->GetPackage());
+			MaterialsCounter++;
+
+			for (UTexture2D* ConnectedTexture : TexturesToConnect)
+			{
+				PackagesToSave.AddUnique(ConnectedTexture->GetPackage());
+			}
+		}
+	}
 
-			Default_CreateMaterialNodes(CreatedMaterial, SelectedTexture, PinsConnectedCounter);
+	//Every texture of the job is rebuilt in parallel by the texture compiler, before any material samples it.
+	PendingTextureSettings.Apply();
 
-			break;
-		case E_ChannelPackingType::ECPT_ORM:
+	{
+		FScopedSlowTask SlowTask(AssembledMaterials.Num(), FText::FromString(TEXT("Compiling created materials")));
+		SlowTask.MakeDialog();
 
-			ORM_CreateMaterialNodes(CreatedMaterial, SelectedTexture, PinsConnectedCounter);
+		//Each material is compiled once, against the final texture settings.
+		for (const FAssembledMaterial& AssembledMaterial : AssembledMaterials)
+		{
+			SlowTask.EnterProgressFrame(1.f, FText::FromString(AssembledMaterial.Name));
+
+			CompileCreatedMaterial(AssembledMaterial.Material);
+
+			if (bCreateMaterialInstance)
+			{
+				//Reserved like the material, an MI_ left from an earlier run gets a numbered name instead of a failed create.
+				FString NameOfMaterialInstance = AssembledMaterial.Name;
+				NameOfMaterialInstance.RemoveFromStart(TEXT("M_"));
+				NameOfMaterialInstance = NameReservation.ReserveUnique(AssembledMaterial.PackagePath, TEXT("MI_") + NameOfMaterialInstance);
+
+				if (UMaterialInstanceConstant* CreatedMI = CreateMaterialInstanceAsset(AssembledMaterial.Material, NameOfMaterialInstance, AssembledMaterial.PackagePath))
+				{
+					PackagesToSave.Add(CreatedMI->GetPackage());
+					InstancesCounter++;
+				}
+			}
+		}
+	}
 
-			break;
-		case E_ChannelPackingType::ECPT_MAX:
-			break;
-		default:
-			break;
+	//One deferred save for everything the job touched.
+	if (PackagesToSave.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	}
+
+	DebugHeader::ShowNotifyInfo(FString::Printf(TEXT("%sCreated %u materials and %u material instances, skipped %u existing"),
+		bCancelled ? TEXT("Cancelled. ") : TEXT(""), MaterialsCounter, InstancesCounter, SkippedCounter));
+
+}//CreateMaterialsFromTextureFolder.
+
+
+void UQuickMaterialWidget::PackSelectedTexturesToORM()
+{
+	TArray<UTexture2D*> SelectedTexturesArray;
+
+	for (const FAssetData& SelectedData : UEditorUtilityLibrary::GetSelectedAssetData())
+	{
+		if (UTexture2D* SelectedTexture = Cast<UTexture2D>(SelectedData.GetAsset()))
+		{
+			SelectedTexturesArray.Add(SelectedTexture);
 		}
-		
 	}
 
-	if (PinsConnectedCounter > 0)
+	if (SelectedTexturesArray.Num() == 0)
 	{
-		DebugHeader::ShowNotifyInfo(TEXT("Successfully connected ") + 
-			FString::FromInt(PinsConnectedCounter)+ (TEXT(" pins")));
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No texture selected"));
+		return;
+	}
 
+	if (UTexture2D* PackedTexture = PackSeparateMapsToORM(SelectedTexturesArray, true))
+	{
+		UEditorLoadingAndSavingUtils::SavePackages({ PackedTexture->GetPackage() }, true);
 	}
 
-	if (bCreateMaterialInstance)
+}//PackSelectedTexturesToORM.
+
+
+void UQuickMaterialWidget::CreateMaterialInstanceVariants()
+{
+	if (!VariantParentMaterial)
 	{
-		CreateMaterialInstanceAsset(CreatedMaterial, MaterialName, SelectedTextureFolderPath);
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please set a parent material"));
+		return;
 	}
 
-	MaterialName = TEXT("M_");
+	UDataTable* VariantsData = LoadVariantTable();
+	if (!VariantsData) return;
 
-}//CreateMaterialFromSelectedTextures.
+	FString OutputFolder = VariantOutputFolder.IsEmpty() ?
+		FPackageName::GetLongPackagePath(VariantParentMaterial->GetPackage()->GetName()) : VariantOutputFolder;
+
+	OutputFolder.RemoveFromEnd(TEXT("/"));
+
+	//A typed folder has to be a long package path under a mounted content root, CreatePackage would take anything.
+	FText InvalidFolderReason;
+	if (!FPackageName::IsValidLongPackageName(OutputFolder, false, &InvalidFolderReason) || !FPackageName::IsValidPath(OutputFolder))
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Output folder ") + OutputFolder +
+			TEXT(" is not a content folder such as /Game/Materials\n") + InvalidFolderReason.ToString(), false);
+		return;
+	}
+
+	//Parameter names are gathered once so misspelled overrides can be reported per row without asking the parent again.
+	TSet<FName> KnownParameterNames;
+	for (EMaterialParameterType ParameterType : { EMaterialParameterType::Scalar, EMaterialParameterType::Vector, EMaterialParameterType::Texture })
+	{
+		TArray<FMaterialParameterInfo> ParameterInfos;
+		TArray<FGuid> ParameterIds;
+		VariantParentMaterial->GetAllParameterInfoOfType(ParameterType, ParameterInfos, ParameterIds);
+
+		for (const FMaterialParameterInfo& ParameterInfo : ParameterInfos)
+		{
+			KnownParameterNames.Add(ParameterInfo.Name);
+		}
+	}
+
+	const TArray<FName> RowNames = VariantsData->GetRowNames();
+
+	FAssetNameReservation NameReservation;
+	TArray<UPackage*> PackagesToSave;
+	PackagesToSave.Reserve(RowNames.Num());
+	uint32 SkippedCounter = 0;
+	uint32 UnknownOverridesCounter = 0;
+	uint32 FailedTextureLoadsCounter = 0;
+	bool bCancelled = false;
+
+	const double GenerateStartTime = FPlatformTime::Seconds();
+
+	{
+		FScopedSlowTask SlowTask(RowNames.Num(), FText::FromString(TEXT("Creating material instance variants")));
+		SlowTask.MakeDialog(true);
+
+		for (const FName& RowName : RowNames)
+		{
+			if (SlowTask.ShouldCancel())
+			{
+				bCancelled = true;
+				break;
+			}
+
+			SlowTask.EnterProgressFrame(1.f);
+
+			const FMaterialInstanceVariantRow* VariantRow = VariantsData->FindRow<FMaterialInstanceVariantRow>(RowName, TEXT("CreateMaterialInstanceVariants"));
+			const FString NameOfMaterialInstance = RowName.ToString();
+
+			if (!VariantRow || !NameReservation.Reserve(OutputFolder, NameOfMaterialInstance))
+			{
+				SkippedCounter++;
+				continue;
+			}
+
+			if (UMaterialInstanceConstant* CreatedMI = CreateMaterialInstanceVariant(VariantParentMaterial, NameOfMaterialInstance,
+				OutputFolder, *VariantRow, KnownParameterNames, UnknownOverridesCounter, FailedTextureLoadsCounter))
+			{
+				PackagesToSave.Add(CreatedMI->GetPackage());
+			}
+		}
+	}
+
+	if (PackagesToSave.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	}
+
+	if (UnknownOverridesCounter > 0)
+	{
+		DebugHeader::PrintLog(FString::Printf(TEXT("%u overrides name parameters that %s does not have, they were skipped"),
+			UnknownOverridesCounter, *VariantParentMaterial->GetName()));
+	}
+
+	if (FailedTextureLoadsCounter > 0)
+	{
+		DebugHeader::PrintLog(FString::Printf(TEXT("%u texture overrides could not be loaded and were left at the parent value"),
+			FailedTextureLoadsCounter));
+	}
+
+	DebugHeader::ShowNotifyInfo(FString::Printf(TEXT("%sCreated %d material instances in %.1f s, skipped %u existing\n%u unknown parameter overrides skipped, %u textures failed to load"),
+		bCancelled ? TEXT("Cancelled. ") : TEXT(""), PackagesToSave.Num(), FPlatformTime::Seconds() - GenerateStartTime,
+		SkippedCounter, UnknownOverridesCounter, FailedTextureLoadsCounter));
+
+}//CreateMaterialInstanceVariants.
+
+
+void UQuickMaterialWidget::FindStructurallyDuplicateMaterials()
+{
+	TArray<TArray<UMaterial*>> Clusters;
+	GatherStructurallyDuplicateMaterials(Clusters);
+
+	if (Clusters.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No structurally duplicate materials found under ") + MaterialAuditFolder, false);
+		return;
+	}
+
+	int32 RedundantMaterialsCounter = 0;
+
+	for (const TArray<UMaterial*>& Cluster : Clusters)
+	{
+		FString ClusterMessage = FString::Printf(TEXT("%d materials share one graph:"), Cluster.Num());
+
+		for (const UMaterial* Material : Cluster)
+		{
+			ClusterMessage += TEXT("\n    ") + Material->GetPathName();
+		}
+
+		DebugHeader::PrintLog(ClusterMessage);
+		RedundantMaterialsCounter += Cluster.Num() - 1;
+	}
+
+	DebugHeader::ShowNotifyInfo(FString::Printf(TEXT("%d groups of duplicate materials, %d could be instances\nSee output log for details"),
+		Clusters.Num(), RedundantMaterialsCounter));
+
+}//FindStructurallyDuplicateMaterials.
+
+
+void UQuickMaterialWidget::CollapseDuplicateMaterialsToInstances()
+{
+	TArray<TArray<UMaterial*>> Clusters;
+	GatherStructurallyDuplicateMaterials(Clusters);
+
+	if (Clusters.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No structurally duplicate materials found under ") + MaterialAuditFolder, false);
+		return;
+	}
+
+	const EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
+		FString::FromInt(Clusters.Num()) + TEXT(" groups of duplicate materials found.\n") +
+		TEXT("Every group keeps its first material as master, the others are replaced by instances of it and deleted.\nContinue?"));
+
+	if (ConfirmResult != EAppReturnType::Yes) return;
+
+	FAssetNameReservation NameReservation;
+	TArray<UPackage*> PackagesToSave;
+	int32 CollapsedClustersCounter = 0;
+	int32 ReplacedMaterialsCounter = 0;
+
+	for (const TArray<UMaterial*>& Cluster : Clusters)
+	{
+		if (CollapseMaterialCluster(Cluster, NameReservation, PackagesToSave))
+		{
+			CollapsedClustersCounter++;
+			ReplacedMaterialsCounter += Cluster.Num() - 1;
+		}
+	}
+
+	if (PackagesToSave.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	}
+
+	DebugHeader::ShowNotifyInfo(FString::Printf(TEXT("Collapsed %d of %d groups, %d materials replaced by instances"),
+		CollapsedClustersCounter, Clusters.Num(), ReplacedMaterialsCounter));
+
+}//CollapseDuplicateMaterialsToInstances.
+
+
+void UQuickMaterialWidget::AnalyzeSelectedTextureRoles()
+{
+	TArray<FAssetData> TexturesData;
+
+	for (const FAssetData& SelectedData : UEditorUtilityLibrary::GetSelectedAssetData())
+	{
+		if (SelectedData.IsInstanceOf(UTexture2D::StaticClass()))
+		{
+			TexturesData.Add(SelectedData);
+		}
+	}
 
+	if (TexturesData.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No texture selected"));
+		return;
+	}
+
+	AnalyzeAndReportTextureRoles(TexturesData);
+
+}//AnalyzeSelectedTextureRoles.
+
+
+void UQuickMaterialWidget::AnalyzeTextureRolesUnderFolder()
+{
+	if (BatchTextureFolder.IsEmpty() || !UEditorAssetLibrary::DoesDirectoryExist(BatchTextureFolder))
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please enter a valid folder"));
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = bBatchIncludeSubfolders;
+	Filter.PackagePaths.Emplace(*BatchTextureFolder);
+	Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+
+	TArray<FAssetData> TexturesData;
+	AssetRegistry.GetAssets(Filter, TexturesData);
+
+	if (TexturesData.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No texture found under ") + BatchTextureFolder, false);
+		return;
+	}
+
+	AnalyzeAndReportTextureRoles(TexturesData);
+
+}//AnalyzeTextureRolesUnderFolder.
 
 #pragma endregion
 
@@ -137,50 +553,424 @@ bool UQuickMaterialWidget::ProcessSelectedData(const TArray<FAssetData>& Selecte
 			MaterialName.RemoveFromStart(TEXT("T_"));
 			MaterialName.InsertAt(0, TEXT("M_"));
 
-			bMaterialNameSet = true;
+			bMaterialNameSet = true;
+
+		}
+
+	}
+	return true;
+}//ProcessSelectedData.
+
+//Groups textures under the folder into sets by their name with the role suffix stripped, from registry data only.
+void UQuickMaterialWidget::GroupTextureSetsUnderFolder(const FString& FolderPathToScan, TArray<FTextureSetGroup>& OutTextureSets)
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = bBatchIncludeSubfolders;
+	Filter.PackagePaths.Emplace(*FolderPathToScan);
+	Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+
+	TArray<FAssetData> TexturesData;
+	AssetRegistry.GetAssets(Filter, TexturesData);
+
+	TMap<FString, int32> SetIndexByKey;
+
+	CompileSuffixMatcherIfChanged();
+
+	for (const FAssetData& TextureData : TexturesData)
+	{
+		FString BaseName;
+		ETextureRole TextureRole;
+		if (!SuffixMatcher.Classify(TextureData.AssetName.ToString(), TextureRole, BaseName) || BaseName.IsEmpty()) continue;
+
+		const FString PackagePath = TextureData.PackagePath.ToString();
+		const FString SetKey = PackagePath / BaseName;
+
+		int32* FoundSetIndex = SetIndexByKey.Find(SetKey);
+
+		if (!FoundSetIndex)
+		{
+			FTextureSetGroup& NewTextureSet = OutTextureSets.AddDefaulted_GetRef();
+			NewTextureSet.BaseName = BaseName;
+			NewTextureSet.PackagePath = PackagePath;
+
+			FoundSetIndex = &SetIndexByKey.Add(SetKey, OutTextureSets.Num() - 1);
+		}
+
+		OutTextureSets[*FoundSetIndex].TexturesData.Add(TextureData);
+	}
+
+}//GroupTextureSetsUnderFolder.
+
+//Recompiles the suffix matcher only when one of the supported name arrays was edited.
+void UQuickMaterialWidget::CompileSuffixMatcherIfChanged()
+{
+	uint32 NamesSignature = 0;
+
+	for (const TArray<FString>* SuffixArray : { &BaseColorArray, &MetallicArray, &RoughnessArray, &NormalArray, &AmbientOcclusionArray, &ORMArray })
+	{
+		NamesSignature = HashCombine(NamesSignature, GetTypeHash(SuffixArray->Num()));
+
+		for (const FString& Suffix : *SuffixArray)
+		{
+			NamesSignature = HashCombine(NamesSignature, GetTypeHash(Suffix));
+		}
+	}
+
+	if (bSuffixMatcherCompiled && NamesSignature == SuffixMatcherSignature) return;
+
+	//Order matters, on equal length the earlier role wins just like the old pin checking order.
+	SuffixMatcher.Reset();
+	SuffixMatcher.AddSuffixes(BaseColorArray, ETextureRole::BaseColor);
+	SuffixMatcher.AddSuffixes(MetallicArray, ETextureRole::Metallic);
+	SuffixMatcher.AddSuffixes(RoughnessArray, ETextureRole::Roughness);
+	SuffixMatcher.AddSuffixes(NormalArray, ETextureRole::Normal);
+	SuffixMatcher.AddSuffixes(AmbientOcclusionArray, ETextureRole::AmbientOcclusion);
+	SuffixMatcher.AddSuffixes(ORMArray, ETextureRole::ORM);
+	SuffixMatcher.Compile();
+
+	SuffixMatcherSignature = NamesSignature;
+	bSuffixMatcherCompiled = true;
+
+}//CompileSuffixMatcherIfChanged.
+
+
+//Role from the name, with the pixels analysed by AnalyzeUnmatchedTextureRoles as fallback for names that match no suffix.
+ETextureRole UQuickMaterialWidget::ResolveTextureRole(UTexture2D* Texture)
+{
+	const ETextureRole NameRole = SuffixMatcher.ClassifyRole(Texture->GetName());
+
+	if (NameRole != ETextureRole::None) return NameRole;
+
+	const ETextureRole* PixelRole = PixelRolesOfUnmatchedTextures.Find(Texture);
+	return PixelRole ? *PixelRole : NameRole;
+
+}//ResolveTextureRole.
+
+//All textures of one material without a matching suffix are read and analysed together, before any pin is wired.
+void UQuickMaterialWidget::AnalyzeUnmatchedTextureRoles(const TArray<UTexture2D*>& Textures)
+{
+	PixelRolesOfUnmatchedTextures.Reset();
+
+	if (!bUsePixelAnalysisForUnmatchedNames) return;
+
+	TArray<UTexture2D*> UnmatchedTextures;
+	for (UTexture2D* Texture : Textures)
+	{
+		if (Texture && SuffixMatcher.ClassifyRole(Texture->GetName()) == ETextureRole::None)
+		{
+			UnmatchedTextures.Add(Texture);
+		}
+	}
+
+	if (UnmatchedTextures.Num() == 0) return;
+
+	TArray<TArray<FColor>> SampleSets;
+	FTextureRoleAnalyzer::ReadSampleSets(UnmatchedTextures, SampleSets);
+
+	TArray<FTextureRoleAnalysis> Analyses;
+	FTextureRoleAnalyzer::AnalyzeSampleSets(SampleSets, Analyses);
+
+	for (int32 TextureIndex = 0; TextureIndex < UnmatchedTextures.Num(); TextureIndex++)
+	{
+		if (Analyses[TextureIndex].bIsValid)
+		{
+			PixelRolesOfUnmatchedTextures.Add(UnmatchedTextures[TextureIndex], Analyses[TextureIndex].Role);
+		}
+	}
+
+}//AnalyzeUnmatchedTextureRoles.
+
+//Sources are read on worker threads, the statistics for all of them are computed in parallel afterwards.
+void UQuickMaterialWidget::AnalyzeAndReportTextureRoles(const TArray<FAssetData>& TexturesData)
+{
+	CompileSuffixMatcherIfChanged();
+
+	TArray<UTexture2D*> Textures;
+	TArray<TArray<FColor>> SampleSets;
+	Textures.Reserve(TexturesData.Num());
+	SampleSets.Reserve(TexturesData.Num());
+
+	const double AnalysisStartTime = FPlatformTime::Seconds();
+
+	{
+		FScopedSlowTask SlowTask(TexturesData.Num(), FText::FromString(TEXT("Reading texture samples")));
+		SlowTask.MakeDialog(true);
+
+		for (const FAssetData& TextureData : TexturesData)
+		{
+			if (SlowTask.ShouldCancel()) return;
+
+			SlowTask.EnterProgressFrame(1.f);
+
+			UTexture2D* Texture = Cast<UTexture2D>(TextureData.GetAsset());
+			TArray<FColor> Samples;
+
+			if (!FTextureRoleAnalyzer::ReadSamples(Texture, Samples)) continue;
+
+			Textures.Add(Texture);
+			SampleSets.Add(MoveTemp(Samples));
+		}
+	}
+
+	TArray<FTextureRoleAnalysis> Analyses;
+	FTextureRoleAnalyzer::AnalyzeSampleSets(SampleSets, Analyses);
+
+	FTextureSettingsBatch SettingsBatch;
+	TArray<UPackage*> PackagesToSave;
+	uint32 WrongRoleCounter = 0;
+	uint32 WrongSettingsCounter = 0;
+
+	uint32 AnalysedCounter = 0;
+
+	for (int32 TextureIndex = 0; TextureIndex < Textures.Num(); TextureIndex++)
+	{
+		UTexture2D* Texture = Textures[TextureIndex];
+		const FTextureRoleAnalysis& Analysis = Analyses[TextureIndex];
+
+		//Source could not be read.
+		if (!Analysis.bIsValid) continue;
+
+		AnalysedCounter++;
+		const ETextureRole NameRole = SuffixMatcher.ClassifyRole(Texture->GetName());
+
+		ETextureRole SuggestedRole = NameRole;
+
+		if (!FTextureRoleAnalyzer::IsNameRoleConsistent(NameRole, Analysis))
+		{
+			DebugHeader::PrintLog(FString::Printf(TEXT("%s is named as %s but its pixels look like %s"),
+				*Texture->GetPathName(), LexToString(NameRole), LexToString(Analysis.Role)));
+
+			SuggestedRole = Analysis.Role;
+			WrongRoleCounter++;
+		}
+		else if (NameRole == ETextureRole::None)
+		{
+			SuggestedRole = Analysis.Role;
+		}
+
+		TextureCompressionSettings SuggestedCompression;
+		bool bSuggestedSRGB;
+		FTextureRoleAnalyzer::GetSuggestedSettings(SuggestedRole, SuggestedCompression, bSuggestedSRGB);
+
+		if (Texture->CompressionSettings == SuggestedCompression && Texture->SRGB == bSuggestedSRGB) continue;
+
+		DebugHeader::PrintLog(FString::Printf(TEXT("%s should use %s with sRGB %s"),
+			*Texture->GetPathName(), *UEnum::GetValueAsString(SuggestedCompression), bSuggestedSRGB ? TEXT("on") : TEXT("off")));
+
+		WrongSettingsCounter++;
+
+		if (bApplySuggestedTextureSettings)
+		{
+			SettingsBatch.Add(Texture, SuggestedCompression, bSuggestedSRGB);
+		}
+	}
+
+	for (UTexture* ChangedTexture : SettingsBatch.Apply())
+	{
+		PackagesToSave.Add(ChangedTexture->GetPackage());
+	}
+
+	if (PackagesToSave.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	}
+
+	DebugHeader::ShowNotifyInfo(FString::Printf(
+		TEXT("Analysed %u textures in %.1f ms\n%u with a misleading name, %u with wrong settings%s\nSee output log for details"),
+		AnalysedCounter, (FPlatformTime::Seconds() - AnalysisStartTime) * 1000.0, WrongRoleCounter, WrongSettingsCounter,
+		bApplySuggestedTextureSettings ? TEXT(" (fixed)") : TEXT("")));
+
+}//AnalyzeAndReportTextureRoles.
+
+//Packs separate AO, Roughness and Metallic maps into one TC_Masks texture and swaps them for it in the array.
+//Returns nullptr and leaves the array untouched when the set already has an ORM map or cannot be packed.
+UTexture2D* UQuickMaterialWidget::PackSeparateMapsToORM(TArray<UTexture2D*>& InOutTextures, bool bShowMsgOnFail)
+{
+	CompileSuffixMatcherIfChanged();
+
+	UTexture2D* OcclusionTexture = nullptr;
+	UTexture2D* RoughnessTexture = nullptr;
+	UTexture2D* MetallicTexture = nullptr;
+	FString SetBaseName;
+
+	for (UTexture2D* Texture : InOutTextures)
+	{
+		if (!Texture) continue;
+
+		FString BaseName;
+		ETextureRole TextureRole;
+		SuffixMatcher.Classify(Texture->GetName(), TextureRole, BaseName);
+
+		switch (TextureRole)
+		{
+		case ETextureRole::ORM:
+			return nullptr;
+		case ETextureRole::AmbientOcclusion:
+			OcclusionTexture = Texture;
+			SetBaseName = BaseName;
+			break;
+		case ETextureRole::Roughness:
+			RoughnessTexture = Texture;
+			break;
+		case ETextureRole::Metallic:
+			MetallicTexture = Texture;
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (!OcclusionTexture || !RoughnessTexture || !MetallicTexture)
+	{
+		if (bShowMsgOnFail)
+		{
+			DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Packing needs one AO, one Roughness and one Metallic texture"));
+		}
+		return nullptr;
+	}
+
+	const FString PackedTextureName = SetBaseName + PackedORMSuffix;
+	const FString PackedTexturePath = FPackageName::GetLongPackagePath(OcclusionTexture->GetPackage()->GetName());
+
+	if (SuffixMatcher.ClassifyRole(PackedTextureName) != ETextureRole::ORM)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, PackedORMSuffix + TEXT(" is not one of the supported ORM suffixes"));
+		return nullptr;
+	}
+
+	if (CheckIsNameUsed(PackedTexturePath, PackedTextureName, bShowMsgOnFail)) return nullptr;
+
+	const double PackStartTime = FPlatformTime::Seconds();
+
+	TArray64<uint8> OcclusionPixels, RoughnessPixels, MetallicPixels;
+	int32 SizeX = 0, SizeY = 0, RoughnessSizeX = 0, RoughnessSizeY = 0, MetallicSizeX = 0, MetallicSizeY = 0;
+
+	if (!FTextureChannelPacker::ReadSourceAsGray8(OcclusionTexture, OcclusionPixels, SizeX, SizeY) ||
+		!FTextureChannelPacker::ReadSourceAsGray8(RoughnessTexture, RoughnessPixels, RoughnessSizeX, RoughnessSizeY) ||
+		!FTextureChannelPacker::ReadSourceAsGray8(MetallicTexture, MetallicPixels, MetallicSizeX, MetallicSizeY))
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Failed to read source data for ") + PackedTextureName);
+		return nullptr;
+	}
+
+	if (SizeX != RoughnessSizeX || SizeX != MetallicSizeX || SizeY != RoughnessSizeY || SizeY != MetallicSizeY)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Texture sizes differ, skipped packing ") + PackedTextureName);
+		return nullptr;
+	}
+
+	TArray64<uint8> PackedPixels;
+	FTextureChannelPacker::InterleaveORM(OcclusionPixels.GetData(), RoughnessPixels.GetData(), MetallicPixels.GetData(),
+		SizeX, SizeY, PackedPixels);
+
+	UTexture2D* PackedTexture = FTextureChannelPacker::CreatePackedTexture(PackedTextureName, PackedTexturePath, SizeX, SizeY, PackedPixels);
+
+	if (!PackedTexture) return nullptr;
+
+	InOutTextures.Remove(OcclusionTexture);
+	InOutTextures.Remove(RoughnessTexture);
+	InOutTextures.Remove(MetallicTexture);
+	InOutTextures.Add(PackedTexture);
+
+	DebugHeader::ShowNotifyInfo(FString::Printf(TEXT("Packed %s (%dx%d) in %.1f ms"),
+		*PackedTextureName, SizeX, SizeY, (FPlatformTime::Seconds() - PackStartTime) * 1000.0));
+
+	return PackedTexture;
+
+}//PackSeparateMapsToORM.
+
+//Will return true if the material name is used by asset under the specified folder
+bool UQuickMaterialWidget::CheckIsNameUsed(const FString& FolderPathToCheck, const FString& MaterialNameToCheck, bool bShowMsgWhenUsed)
+{
+	if (!FAssetNameReservation::IsNameUsed(FolderPathToCheck, MaterialNameToCheck)) return false;
+
+	if (bShowMsgWhenUsed)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, MaterialNameToCheck +
+			TEXT(" is already used by asset"));
+	}
+
+	return true;
+
+}//CheckIsNameUsed.
+
+UMaterial* UQuickMaterialWidget::CreateMaterialAsset(const FString& NameOfTheMaterial, const FString& PathToPutMaterial)
+{
+	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+
+	UMaterialFactoryNew* MaterialFactory = NewObject<UMaterialFactoryNew>();
+
+	UObject* CreatedObject = AssetToolsModule.Get().CreateAsset(NameOfTheMaterial, PathToPutMaterial,
+		UMaterial::StaticClass(), MaterialFactory);
+
+	return Cast<UMaterial>(CreatedObject);
+}//CreateMaterialAsset.
+
+//Wires every texture into the material, then compiles the finished graph once.
+double UQuickMaterialWidget::AssembleAndCompileMaterial(UMaterial* CreatedMaterial, const TArray<UTexture2D*>& TexturesToConnect, uint32& PinsConnectedCounter)
+{
+	AssembleMaterialGraph(CreatedMaterial, TexturesToConnect, PinsConnectedCounter);
 
-		}
+	//Texture settings are in place before the shader map is built from them.
+	PendingTextureSettings.Apply();
 
-	}
-	return true;
-}//ProcessSelectedData.
+	//Graph is fully wired at this point, pay for the shader map once.
+	return CompileCreatedMaterial(CreatedMaterial);
 
+}//AssembleAndCompileMaterial.
 
-//Will return true if the material name is used by asset under the specified folder
-bool UQuickMaterialWidget::CheckIsNameUsed(const FString& FolderPathToCheck, const FString& MaterialNameToCheck)
+//Wiring only, nothing is compiled and no texture setting is applied yet.
+void UQuickMaterialWidget::AssembleMaterialGraph(UMaterial* CreatedMaterial, const TArray<UTexture2D*>& TexturesToConnect, uint32& PinsConnectedCounter)
 {
+	CompileSuffixMatcherIfChanged();
+	AnalyzeUnmatchedTextureRoles(TexturesToConnect);
 
-	TArray<FString> ExistingAssetsPaths = UEditorAssetLibrary::ListAssets(FolderPathToCheck, false);
-
-	for (const FString& ExistingAssetPath : ExistingAssetsPaths)
+	for (UTexture2D* SelectedTexture : TexturesToConnect)
 	{
-		const FString ExistingAssetName = FPaths::GetBaseFilename(ExistingAssetPath);
+		if (!SelectedTexture) continue;
 
-		if (ExistingAssetName.Equals(MaterialNameToCheck))
+		switch (ChannelPackingType)
 		{
-			DebugHeader::ShowMsgDialog(EAppMsgType::Ok, MaterialNameToCheck +
-				TEXT(" is already used by asset"));
+		case E_ChannelPackingType::ECPT_NoChannelPacking:
+
+			Default_CreateMaterialNodes(CreatedMaterial, SelectedTexture, PinsConnectedCounter);
+
+			break;
+		case E_ChannelPackingType::ECPT_ORM:
 
-			return true;
+			ORM_CreateMaterialNodes(CreatedMaterial, SelectedTexture, PinsConnectedCounter);
+
+			break;
+		case E_ChannelPackingType::ECPT_MAX:
+			break;
+		default:
+			break;
 		}
+		
 	}
 
-	return false;
+}//AssembleMaterialGraph.
 
-	
-}
-
-UMaterial* UQuickMaterialWidget::CreateMaterialAsset(const FString& NameOfTheMaterial, const FString& PathToPutMaterial)
+//Single compile for a fully assembled material graph, returns the seconds spent.
+double UQuickMaterialWidget::CompileCreatedMaterial(UMaterial* CreatedMaterial)
 {
-	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+	const double CompileStartTime = FPlatformTime::Seconds();
+	{
+		FMaterialUpdateContext UpdateContext;
 
-	UMaterialFactoryNew* MaterialFactory = NewObject<UMaterialFactoryNew>();
+		CreatedMaterial->PreEditChange(nullptr);
+		CreatedMaterial->PostEditChange();
 
-	UObject* CreatedObject = AssetToolsModule.Get().CreateAsset(NameOfTheMaterial, PathToPutMaterial,
-		UMaterial::StaticClass(), MaterialFactory);
+		UpdateContext.AddMaterial(CreatedMaterial);
+	}
+	CreatedMaterial->MarkPackageDirty();
 
-	return Cast<UMaterial>(CreatedObject);
-}//CreateMaterialAsset.
+	return FPlatformTime::Seconds() - CompileStartTime;
+
+}//CompileCreatedMaterial.
 
 void UQuickMaterialWidget::Default_CreateMaterialNodes(UMaterial* CreatedMaterial,
 	UTexture2D* SelectedTexture, uint32& PinsConnectedCounter)
@@ -190,10 +980,13 @@ void UQuickMaterialWidget::Default_CreateMaterialNodes(UMaterial* CreatedMateria
 
 	if (!TextureSampleNode) return;
 
+	//One pass over the name decides which pin the texture belongs to.
+	const ETextureRole TextureRole = ResolveTextureRole(SelectedTexture);
+
 	//checking for basecolor pin.
 	if (!CreatedMaterial->HasBaseColorConnected())
 	{
-		if (TryConnectBaseColor(TextureSampleNode, SelectedTexture, CreatedMaterial))
+		if (TryConnectBaseColor(TextureSampleNode, SelectedTexture, CreatedMaterial, TextureRole))
 		{
 			PinsConnectedCounter++;
 			return;
@@ -203,7 +996,7 @@ void UQuickMaterialWidget::Default_CreateMaterialNodes(UMaterial* CreatedMateria
 	//checking for metallic pin.
 	if (!CreatedMaterial->HasMetallicConnected())
 	{
-		if (TryConnectMetallic(TextureSampleNode, SelectedTexture, CreatedMaterial))
+		if (TryConnectMetallic(TextureSampleNode, SelectedTexture, CreatedMaterial, TextureRole))
 		{
 			PinsConnectedCounter++;
 			return;
@@ -214,7 +1007,7 @@ void UQuickMaterialWidget::Default_CreateMaterialNodes(UMaterial* CreatedMateria
 	//checking for Roughness pin
 	if (!CreatedMaterial->HasRoughnessConnected())
 	{
-		if (TryConnectRoughness(TextureSampleNode, SelectedTexture, CreatedMaterial))
+		if (TryConnectRoughness(TextureSampleNode, SelectedTexture, CreatedMaterial, TextureRole))
 		{
 			PinsConnectedCounter++;
 			return;
@@ -225,7 +1018,7 @@ void UQuickMaterialWidget::Default_CreateMaterialNodes(UMaterial* CreatedMateria
 	//checking for Normal pin
 	if (!CreatedMaterial->HasNormalConnected())
 	{
-		if (TryConnectNormal(TextureSampleNode, SelectedTexture, CreatedMaterial))
+		if (TryConnectNormal(TextureSampleNode, SelectedTexture, CreatedMaterial, TextureRole))
 		{
 			PinsConnectedCounter++;
 			return;
@@ -236,7 +1029,7 @@ void UQuickMaterialWidget::Default_CreateMaterialNodes(UMaterial* CreatedMateria
 	//checking for Normal pin
 	if (!CreatedMaterial->HasAmbientOcclusionConnected())
 	{
-		if (TryConnectAO(TextureSampleNode, SelectedTexture, CreatedMaterial))
+		if (TryConnectAO(TextureSampleNode, SelectedTexture, CreatedMaterial, TextureRole))
 		{
 			PinsConnectedCounter++;
 			return;
@@ -256,10 +1049,13 @@ void UQuickMaterialWidget::ORM_CreateMaterialNodes(UMaterial* CreatedMaterial, U
 
 	if (!TextureSampleNode) return;
 
+	//One pass over the name decides which pin the texture belongs to.
+	const ETextureRole TextureRole = ResolveTextureRole(SelectedTexture);
+
 	//checking for basecolor pin.
 	if (!CreatedMaterial->HasBaseColorConnected())
 	{
-		if (TryConnectBaseColor(TextureSampleNode, SelectedTexture, CreatedMaterial))
+		if (TryConnectBaseColor(TextureSampleNode, SelectedTexture, CreatedMaterial, TextureRole))
 		{
 			PinsConnectedCounter++;
 			return;
@@ -269,7 +1065,7 @@ void UQuickMaterialWidget::ORM_CreateMaterialNodes(UMaterial* CreatedMaterial, U
 	//checking for Normal pin
 	if (!CreatedMaterial->HasNormalConnected())
 	{
-		if (TryConnectNormal(TextureSampleNode, SelectedTexture, CreatedMaterial))
+		if (TryConnectNormal(TextureSampleNode, SelectedTexture, CreatedMaterial, TextureRole))
 		{
 			PinsConnectedCounter++;
 			return;
@@ -281,7 +1077,7 @@ void UQuickMaterialWidget::ORM_CreateMaterialNodes(UMaterial* CreatedMaterial, U
 
 	if (!CreatedMaterial->HasRoughnessConnected())
 	{
-		if (TryConnectORM(TextureSampleNode, SelectedTexture, CreatedMaterial))
+		if (TryConnectORM(TextureSampleNode, SelectedTexture, CreatedMaterial, TextureRole))
 		{
 			PinsConnectedCounter+=3;
 			return;
@@ -295,181 +1091,625 @@ void UQuickMaterialWidget::ORM_CreateMaterialNodes(UMaterial* CreatedMaterial, U
 
 #pragma region CreateMaterialNodesConnectedPins
 
-bool UQuickMaterialWidget::TryConnectBaseColor(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial)
+bool UQuickMaterialWidget::TryConnectBaseColor(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial, ETextureRole TextureRole)
+{
+	if (TextureRole != ETextureRole::BaseColor) return false;
+
+	//Connect pins to base color socket here
+	TextureSampleNode->Texture = SelectedTexture;
+
+	CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
+	CreatedMaterial->GetExpressionInputForProperty(MP_BaseColor)->Connect(0, TextureSampleNode);
+
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+
+	return true;
+}
+
+
+bool UQuickMaterialWidget::TryConnectMetallic(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial, ETextureRole TextureRole)
+{
+	if (TextureRole != ETextureRole::Metallic) return false;
+
+	PendingTextureSettings.Add(SelectedTexture, TextureCompressionSettings::TC_Default, false);
+
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+
+	CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
+	CreatedMaterial->GetExpressionInputForProperty(MP_Metallic)->Connect(0, TextureSampleNode);
+
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 240;
+	
+	return true;
+}//TryConnectMetallic.
+
+
+bool UQuickMaterialWidget::TryConnectRoughness(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial, ETextureRole TextureRole)
+{
+	if (TextureRole != ETextureRole::Roughness) return false;
+
+	PendingTextureSettings.Add(SelectedTexture, TextureCompressionSettings::TC_Default, false);
+
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+
+	CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
+	CreatedMaterial->GetExpressionInputForProperty(MP_Roughness)->Connect(0, TextureSampleNode);
+
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 500;
+
+	return true;
+
+}//TryConnectRoughness.
+
+
+bool UQuickMaterialWidget::TryConnectNormal(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial, ETextureRole TextureRole)
+{
+	if (TextureRole != ETextureRole::Normal) return false;
+
+	//dont need to change texture as engine does while importing.
+	/*
+	SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Normalmap;
+	SelectedTexture->SRGB = false;
+	SelectedTexture->PostEditChange();
+	*/
+
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Normal;
+
+	CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
+	CreatedMaterial->GetExpressionInputForProperty(MP_Normal)->Connect(0, TextureSampleNode);
+
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 800;
+
+	return true;
+
+}//TryConnectNormal.
+
+
+bool UQuickMaterialWidget::TryConnectAO(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial, ETextureRole TextureRole)
+{
+	if (TextureRole != ETextureRole::AmbientOcclusion) return false;
+
+	PendingTextureSettings.Add(SelectedTexture, TextureCompressionSettings::TC_Default, false);
+
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+
+	CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
+	CreatedMaterial->GetExpressionInputForProperty(MP_AmbientOcclusion)->Connect(0, TextureSampleNode);
+
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 1100;
+
+	return true;
+
+}//TryConnectAO.
+
+
+
+bool UQuickMaterialWidget::TryConnectORM(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial, ETextureRole TextureRole)
+{
+	if (TextureRole != ETextureRole::ORM) return false;
+
+	PendingTextureSettings.Add(SelectedTexture, TextureCompressionSettings::TC_Masks, false);
+
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Masks;
+	
+	CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
+	CreatedMaterial->GetExpressionInputForProperty(MP_AmbientOcclusion)->Connect(1, TextureSampleNode);
+	CreatedMaterial->GetExpressionInputForProperty(MP_Roughness)->Connect(2, TextureSampleNode);
+	CreatedMaterial->GetExpressionInputForProperty(MP_Metallic)->Connect(3, TextureSampleNode);
+
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 450;
+
+	return true;
+}//TryConnectORM.
+
+#pragma endregion
+
+#pragma region Diagnostics
+
+void UQuickMaterialWidget::BenchmarkTextureNameClassification()
 {
-	for (const FString& BaseColorName : BaseColorArray)
+	const TArray<FString>* SuffixArrays[] = { &BaseColorArray, &MetallicArray, &RoughnessArray, &NormalArray, &AmbientOcclusionArray, &ORMArray };
+	const int32 NumOfNames = 100000;
+
+	//Mix of every supported suffix plus names that match nothing, the worst case for the old scan.
+	TArray<FString> TextureNames;
+	TextureNames.Reserve(NumOfNames);
+
+	FRandomStream NameStream(NumOfNames);
+
+	for (int32 NameIndex = 0; NameIndex < NumOfNames; NameIndex++)
 	{
-		if (SelectedTexture->GetName().Contains(BaseColorName))
-		{
-			//Connect pins to base color socket here
-			TextureSampleNode->Texture = SelectedTexture;
+		const TArray<FString>& SuffixArray = *SuffixArrays[NameStream.RandRange(0, UE_ARRAY_COUNT(SuffixArrays) - 1)];
+		const bool bUnmatched = SuffixArray.Num() == 0 || NameStream.FRand() < 0.1f;
+
+		TextureNames.Add(FString::Printf(TEXT("T_BenchmarkAsset_%d%s"), NameIndex,
+			bUnmatched ? TEXT("_Mask") : *SuffixArray[NameStream.RandRange(0, SuffixArray.Num() - 1)]));
+	}
 
-			CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
-			CreatedMaterial->GetExpressionInputForProperty(MP_BaseColor)->Connect(0, TextureSampleNode);
-			CreatedMaterial->PostEditChange();
+	//Previous approach, substring scan of every array in pin order.
+	int32 ScanMatches = 0;
+	const double ScanStartTime = FPlatformTime::Seconds();
 
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
+	for (const FString& TextureName : TextureNames)
+	{
+		bool bFound = false;
 
-			return true;
+		for (const TArray<FString>* SuffixArray : SuffixArrays)
+		{
+			for (const FString& Suffix : *SuffixArray)
+			{
+				if (TextureName.Contains(Suffix))
+				{
+					bFound = true;
+					break;
+				}
+			}
+			if (bFound) break;
 		}
+		ScanMatches += bFound ? 1 : 0;
 	}
 
-	return false;
-}
+	const double ScanSeconds = FPlatformTime::Seconds() - ScanStartTime;
+
+	bSuffixMatcherCompiled = false;
+	const double CompileStartTime = FPlatformTime::Seconds();
+	CompileSuffixMatcherIfChanged();
+	const double CompileSeconds = FPlatformTime::Seconds() - CompileStartTime;
+
+	int32 MatcherMatches = 0;
+	const double MatcherStartTime = FPlatformTime::Seconds();
+
+	for (const FString& TextureName : TextureNames)
+	{
+		MatcherMatches += SuffixMatcher.ClassifyRole(TextureName) != ETextureRole::None ? 1 : 0;
+	}
+
+	const double MatcherSeconds = FPlatformTime::Seconds() - MatcherStartTime;
 
+	const FString BenchmarkResult = FString::Printf(
+		TEXT("Classified %d names\nSubstring scan: %.2f ms (%d matched)\nSuffix matcher: %.2f ms (%d matched), compile %.3f ms\nSpeedup: %.1fx"),
+		NumOfNames, ScanSeconds * 1000.0, ScanMatches, MatcherSeconds * 1000.0, MatcherMatches,
+		CompileSeconds * 1000.0, MatcherSeconds > 0.0 ? ScanSeconds / MatcherSeconds : 0.0);
 
-bool UQuickMaterialWidget::TryConnectMetallic(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial)
+	DebugHeader::PrintLog(BenchmarkResult);
+	DebugHeader::ShowNotifyInfo(BenchmarkResult);
+
+}//BenchmarkTextureNameClassification.
+
+#pragma endregion
+
+
+
+//The table asset if set, otherwise a transient table imported from the CSV file.
+UDataTable* UQuickMaterialWidget::LoadVariantTable()
 {
-	for (const FString& MetallicName : MetallicArray)
+	if (VariantTable)
 	{
-		if (SelectedTexture->GetName().Contains(MetallicName))
+		if (VariantTable->GetRowStruct() != FMaterialInstanceVariantRow::StaticStruct())
 		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
+			DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Variant table rows must be MaterialInstanceVariantRow"));
+			return nullptr;
+		}
+		return VariantTable;
+	}
 
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+	FString CSVContent;
+	if (VariantCSVFile.FilePath.IsEmpty() || !FFileHelper::LoadFileToString(CSVContent, *VariantCSVFile.FilePath))
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please set a variant table or a valid CSV file"));
+		return nullptr;
+	}
 
-			CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
-			CreatedMaterial->GetExpressionInputForProperty(MP_Metallic)->Connect(0, TextureSampleNode);
-			CreatedMaterial->PostEditChange();
+	UDataTable* CSVTable = NewObject<UDataTable>(GetTransientPackage());
+	CSVTable->RowStruct = FMaterialInstanceVariantRow::StaticStruct();
 
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 240;
-			
-			return true;
-		}
+	const TArray<FString> ImportProblems = CSVTable->CreateTableFromCSVString(CSVContent);
+
+	for (const FString& ImportProblem : ImportProblems)
+	{
+		DebugHeader::PrintLog(ImportProblem);
 	}
-	return false;
-}//TryConnectMetallic.
 
+	if (CSVTable->GetRowMap().Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No rows could be read from ") + VariantCSVFile.FilePath);
+		return nullptr;
+	}
+
+	return CSVTable;
+
+}//LoadVariantTable.
 
-bool UQuickMaterialWidget::TryConnectRoughness(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial)
+//Overrides go through the editor only setters, so the instance is post edited once after all of them.
+//Overrides naming a parameter the parent does not have are counted and skipped, they would only be dead data in the instance.
+UMaterialInstanceConstant* UQuickMaterialWidget::CreateMaterialInstanceVariant(UMaterialInterface* ParentMaterial, const FString& NameOfMaterialInstance,
+	const FString& PathToPutMI, const FMaterialInstanceVariantRow& VariantRow, const TSet<FName>& KnownParameterNames, uint32& UnknownOverridesCounter,
+	uint32& FailedTextureLoadsCounter)
 {
-	for (const FString& RoughnessName : RoughnessArray)
+	UPackage* InstancePackage = CreatePackage(*(PathToPutMI / NameOfMaterialInstance));
+	if (!InstancePackage) return nullptr;
+
+	UMaterialInstanceConstant* CreatedMI = NewObject<UMaterialInstanceConstant>(InstancePackage, *NameOfMaterialInstance,
+		RF_Public | RF_Standalone | RF_Transactional);
+
+	CreatedMI->SetParentEditorOnly(ParentMaterial, false);
+
+	for (const TPair<FName, float>& ScalarOverride : VariantRow.ScalarOverrides)
 	{
-		if (SelectedTexture->GetName().Contains(RoughnessName))
+		if (!KnownParameterNames.Contains(ScalarOverride.Key))
 		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
+			UnknownOverridesCounter++;
+			continue;
+		}
+
+		CreatedMI->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(ScalarOverride.Key), ScalarOverride.Value);
+	}
 
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+	for (const TPair<FName, FLinearColor>& VectorOverride : VariantRow.VectorOverrides)
+	{
+		if (!KnownParameterNames.Contains(VectorOverride.Key))
+		{
+			UnknownOverridesCounter++;
+			continue;
+		}
 
-			CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
-			CreatedMaterial->GetExpressionInputForProperty(MP_Roughness)->Connect(0, TextureSampleNode);
-			CreatedMaterial->PostEditChange();
+		CreatedMI->SetVectorParameterValueEditorOnly(FMaterialParameterInfo(VectorOverride.Key), VectorOverride.Value);
+	}
 
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 500;
+	for (const TPair<FName, TSoftObjectPtr<UTexture>>& TextureOverride : VariantRow.TextureOverrides)
+	{
+		if (!KnownParameterNames.Contains(TextureOverride.Key))
+		{
+			UnknownOverridesCounter++;
+			continue;
+		}
 
-			return true;
+		UTexture* OverrideTexture = TextureOverride.Value.LoadSynchronous();
+		if (!OverrideTexture)
+		{
+			FailedTextureLoadsCounter++;
+			DebugHeader::PrintLog(TEXT("Failed to load texture override ") + TextureOverride.Value.ToString() + TEXT(" for ") + NameOfMaterialInstance);
+			continue;
 		}
+
+		CreatedMI->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(TextureOverride.Key), OverrideTexture);
 	}
-	return false;
 
-}//TryConnectRoughness.
+	CreatedMI->PostEditChange();
+
+	FAssetRegistryModule::AssetCreated(CreatedMI);
+	CreatedMI->MarkPackageDirty();
+
+	return CreatedMI;
 
+}//CreateMaterialInstanceVariant.
 
-bool UQuickMaterialWidget::TryConnectNormal(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial)
+//Groups materials under MaterialAuditFolder by graph hash, only groups with more than one material are returned.
+void UQuickMaterialWidget::GatherStructurallyDuplicateMaterials(TArray<TArray<UMaterial*>>& OutClusters)
 {
-	for (const FString& NormalName : NormalArray)
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.PackagePaths.Emplace(*MaterialAuditFolder);
+	Filter.ClassPaths.Add(UMaterial::StaticClass()->GetClassPathName());
+
+	TArray<FAssetData> MaterialsData;
+	AssetRegistry.GetAssets(Filter, MaterialsData);
+
+	//Sorted by path so the master of every group is stable between runs.
+	MaterialsData.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+
+	TMap<uint64, TArray<UMaterial*>> MaterialsByGraphHash;
+
+	{
+		FScopedSlowTask SlowTask(MaterialsData.Num(), FText::FromString(TEXT("Hashing material graphs")));
+		SlowTask.MakeDialog(true);
+
+		for (const FAssetData& MaterialData : MaterialsData)
+		{
+			if (SlowTask.ShouldCancel()) return;
+
+			SlowTask.EnterProgressFrame(1.f);
+
+			if (UMaterial* Material = Cast<UMaterial>(MaterialData.GetAsset()))
+			{
+				MaterialsByGraphHash.FindOrAdd(FMaterialGraphHasher::HashMaterial(Material)).Add(Material);
+			}
+		}
+	}
+
+	for (TPair<uint64, TArray<UMaterial*>>& HashCluster : MaterialsByGraphHash)
 	{
-		if (SelectedTexture->GetName().Contains(NormalName))
+		if (HashCluster.Value.Num() > 1)
 		{
-			//dont need to change texture as engine does while importing.
-			/*
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Normalmap;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
-			*/
+			OutClusters.Add(MoveTemp(HashCluster.Value));
+		}
+	}
+
+}//GatherStructurallyDuplicateMaterials.
 
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Normal;
+//A UMaterial can be swapped for an instance only where every property holding it accepts a material instance.
+//Loads the referencing packages, so the caller can save them once they point at the instance.
+static bool CanReferencersTakeMaterialInstance(UMaterial* Material, TArray<UPackage*>& OutReferencerPackages)
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FName> Referencers;
+	AssetRegistry.GetReferencers(Material->GetPackage()->GetFName(), Referencers);
 
-			CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
-			CreatedMaterial->GetExpressionInputForProperty(MP_Normal)->Connect(0, TextureSampleNode);
-			CreatedMaterial->PostEditChange();
+	bool bCompatible = true;
 
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 800;
+	for (const FName& Referencer : Referencers)
+	{
+		UPackage* ReferencerPackage = LoadPackage(nullptr, *Referencer.ToString(), LOAD_None);
 
-			return true;
+		if (!ReferencerPackage)
+		{
+			DebugHeader::PrintLog(TEXT("Failed to load referencer ") + Referencer.ToString() + TEXT(" of ") + Material->GetPathName());
+			return false;
 		}
+
+		ForEachObjectWithPackage(ReferencerPackage, [Material, &bCompatible](UObject* Object)
+			{
+				for (TPropertyValueIterator<FObjectPropertyBase> It(Object->GetClass(), Object); It && bCompatible; ++It)
+				{
+					if (It.Key()->GetObjectPropertyValue(It.Value()) == Material &&
+						!UMaterialInstanceConstant::StaticClass()->IsChildOf(It.Key()->PropertyClass))
+					{
+						DebugHeader::PrintLog(Object->GetPathName() + TEXT(".") + It.Key()->GetName() + TEXT(" only takes a ") +
+							It.Key()->PropertyClass->GetName() + TEXT(", ") + Material->GetName() + TEXT(" cannot become an instance"));
+						bCompatible = false;
+					}
+				}
+
+				return bCompatible;
+			});
+
+		if (!bCompatible) return false;
+
+		OutReferencerPackages.AddUnique(ReferencerPackage);
 	}
-	return false;
 
-}//TryConnectNormal.
+	return true;
 
+}//CanReferencersTakeMaterialInstance.
 
-bool UQuickMaterialWidget::TryConnectAO(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial)
+//Everything is validated before the master is touched, a group that cannot be collapsed is left as it is.
+bool UQuickMaterialWidget::CollapseMaterialCluster(const TArray<UMaterial*>& Cluster, FAssetNameReservation& NameReservation,
+	TArray<UPackage*>& OutPackagesToSave)
 {
-	for (const FString& AOName : AmbientOcclusionArray)
+	UMaterial* MasterMaterial = Cluster[0];
+
+	TArray<UMaterialExpressionTextureBase*> MasterTextureNodes;
+	const uint64 MasterHash = FMaterialGraphHasher::HashMaterial(MasterMaterial, &MasterTextureNodes);
+
+	TArray<TArray<UMaterialExpressionTextureBase*>> MemberTextureNodes;
+	MemberTextureNodes.SetNum(Cluster.Num());
+
+	for (int32 MemberIndex = 1; MemberIndex < Cluster.Num(); MemberIndex++)
+	{
+		if (FMaterialGraphHasher::HashMaterial(Cluster[MemberIndex], &MemberTextureNodes[MemberIndex]) != MasterHash ||
+			MemberTextureNodes[MemberIndex].Num() != MasterTextureNodes.Num())
+		{
+			DebugHeader::PrintLog(TEXT("Graph walk differs, skipped group of ") + MasterMaterial->GetPathName());
+			return false;
+		}
+	}
+
+	TSet<FName> UsedParameterNames;
+	for (UMaterialExpressionTextureBase* TextureNode : MasterTextureNodes)
+	{
+		if (const UMaterialExpressionTextureSampleParameter* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter>(TextureNode))
+		{
+			UsedParameterNames.Add(ParameterNode->ParameterName);
+		}
+	}
+
+	//NAME_None marks a node that stays a constant texture, every member has to sample the same one there.
+	TArray<FName> ParameterNames;
+	ParameterNames.Init(NAME_None, MasterTextureNodes.Num());
+
+	for (int32 NodeIndex = 0; NodeIndex < MasterTextureNodes.Num(); NodeIndex++)
 	{
-		if (SelectedTexture->GetName().Contains(AOName))
+		UMaterialExpressionTextureBase* MasterNode = MasterTextureNodes[NodeIndex];
+
+		if (const UMaterialExpressionTextureSampleParameter* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter>(MasterNode))
 		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
+			ParameterNames[NodeIndex] = ParameterNode->ParameterName;
+			continue;
+		}
+
+		if (MasterNode->GetClass() == UMaterialExpressionTextureSample::StaticClass())
+		{
+			int32 Suffix = NodeIndex;
+			FName NewParameterName(*FString::Printf(TEXT("Texture_%d"), Suffix));
+
+			while (UsedParameterNames.Contains(NewParameterName))
+			{
+				NewParameterName = FName(*FString::Printf(TEXT("Texture_%d"), ++Suffix));
+			}
 
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+			UsedParameterNames.Add(NewParameterName);
+			ParameterNames[NodeIndex] = NewParameterName;
+			continue;
+		}
 
-			CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
-			CreatedMaterial->GetExpressionInputForProperty(MP_AmbientOcclusion)->Connect(0, TextureSampleNode);
-			CreatedMaterial->PostEditChange();
+		for (int32 MemberIndex = 1; MemberIndex < Cluster.Num(); MemberIndex++)
+		{
+			if (MemberTextureNodes[MemberIndex][NodeIndex]->Texture != MasterNode->Texture)
+			{
+				DebugHeader::PrintLog(TEXT("Texture object node cannot become a parameter, skipped group of ") + MasterMaterial->GetPathName());
+				return false;
+			}
+		}
+	}
 
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 1100;
+	//A member held by a property that only takes a UMaterial keeps its own material, the rest of the group still collapses.
+	TArray<TArray<UPackage*>> MemberReferencerPackages;
+	MemberReferencerPackages.SetNum(Cluster.Num());
+	TBitArray<> CanReplaceMember(false, Cluster.Num());
+	bool bAnyReplaceableMember = false;
 
-			return true;
+	for (int32 MemberIndex = 1; MemberIndex < Cluster.Num(); MemberIndex++)
+	{
+		if (CanReferencersTakeMaterialInstance(Cluster[MemberIndex], MemberReferencerPackages[MemberIndex]))
+		{
+			CanReplaceMember[MemberIndex] = true;
+			bAnyReplaceableMember = true;
 		}
 	}
-	return false;
 
-}//TryConnectAO.
+	if (!bAnyReplaceableMember)
+	{
+		DebugHeader::PrintLog(TEXT("No duplicate can be replaced by an instance, skipped group of ") + MasterMaterial->GetPathName());
+		return false;
+	}
+
+	MasterMaterial->Modify();
+
+	for (int32 NodeIndex = 0; NodeIndex < MasterTextureNodes.Num(); NodeIndex++)
+	{
+		if (ParameterNames[NodeIndex].IsNone() || MasterTextureNodes[NodeIndex]->IsA<UMaterialExpressionTextureSampleParameter>()) continue;
+
+		ConvertTextureSampleToParameter(MasterMaterial, CastChecked<UMaterialExpressionTextureSample>(MasterTextureNodes[NodeIndex]),
+			ParameterNames[NodeIndex]);
+	}
+
+	CompileCreatedMaterial(MasterMaterial);
+	OutPackagesToSave.AddUnique(MasterMaterial->GetPackage());
+
+	const TSet<FName> KnownParameterNames(ParameterNames);
+
+	for (int32 MemberIndex = 1; MemberIndex < Cluster.Num(); MemberIndex++)
+	{
+		if (!CanReplaceMember[MemberIndex]) continue;
+
+		UMaterial* MemberMaterial = Cluster[MemberIndex];
+
+		FMaterialInstanceVariantRow VariantRow;
+		for (int32 NodeIndex = 0; NodeIndex < MasterTextureNodes.Num(); NodeIndex++)
+		{
+			UTexture* MemberTexture = MemberTextureNodes[MemberIndex][NodeIndex]->Texture;
+
+			if (!ParameterNames[NodeIndex].IsNone() && MemberTexture != MasterTextureNodes[NodeIndex]->Texture)
+			{
+				VariantRow.TextureOverrides.Add(ParameterNames[NodeIndex], MemberTexture);
+			}
+		}
 
+		const FString MemberPackagePath = FPackageName::GetLongPackagePath(MemberMaterial->GetPackage()->GetName());
 
+		FString NameOfMaterialInstance = MemberMaterial->GetName();
+		NameOfMaterialInstance.RemoveFromStart(TEXT("M_"));
+		NameOfMaterialInstance = NameReservation.ReserveUnique(MemberPackagePath, TEXT("MI_") + NameOfMaterialInstance);
 
-bool UQuickMaterialWidget::TryConnectORM(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial)
+		uint32 UnknownOverridesCounter = 0;
+		uint32 FailedTextureLoadsCounter = 0;
+		UMaterialInstanceConstant* CreatedMI = CreateMaterialInstanceVariant(MasterMaterial, NameOfMaterialInstance,
+			MemberPackagePath, VariantRow, KnownParameterNames, UnknownOverridesCounter, FailedTextureLoadsCounter);
+
+		if (!CreatedMI) continue;
+
+		OutPackagesToSave.Add(CreatedMI->GetPackage());
+
+		//Every reference to the duplicate now points at the instance, the duplicate itself is deleted.
+		TArray<UObject*> ObjectsToConsolidate = { MemberMaterial };
+		const ObjectTools::FConsolidationResults ConsolidationResults = ObjectTools::ConsolidateObjects(CreatedMI, ObjectsToConsolidate, false);
+
+		//Consolidation only dirties the referencers, they are saved with the rest of the job.
+		for (UPackage* ReferencerPackage : MemberReferencerPackages[MemberIndex])
+		{
+			OutPackagesToSave.AddUnique(ReferencerPackage);
+		}
+
+		for (UPackage* DirtiedPackage : ConsolidationResults.DirtiedPackages)
+		{
+			OutPackagesToSave.AddUnique(DirtiedPackage);
+		}
+	}
+
+	return true;
+
+}//CollapseMaterialCluster.
+
+//Swaps a texture sample for a texture parameter with the same settings and links.
+UMaterialExpressionTextureSampleParameter2D* UQuickMaterialWidget::ConvertTextureSampleToParameter(UMaterial* Material,
+	UMaterialExpressionTextureSample* TextureSampleNode, FName ParameterName)
 {
-	for (const FString& ORMName : ORMArray)
+	UMaterialExpressionTextureSampleParameter2D* ParameterNode =
+		NewObject<UMaterialExpressionTextureSampleParameter2D>(Material, NAME_None, RF_Transactional);
+
+	//Only the texture sample fields and those of its texture base, the expression fields would carry over the graph node and GUIDs.
+	for (UClass* CopiedClass : { UMaterialExpressionTextureSample::StaticClass(), UMaterialExpressionTextureBase::StaticClass() })
 	{
-		if (SelectedTexture->GetName().Contains(ORMName))
+		for (TFieldIterator<FProperty> PropertyIt(CopiedClass, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
 		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Masks;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
+			if (PropertyIt->HasAnyPropertyFlags(CPF_Transient)) continue;
+
+			PropertyIt->CopyCompleteValue_InContainer(ParameterNode, TextureSampleNode);
+		}
+	}
 
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Masks;
-			
-			CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
-			CreatedMaterial->GetExpressionInputForProperty(MP_AmbientOcclusion)->Connect(1, TextureSampleNode);
-			CreatedMaterial->GetExpressionInputForProperty(MP_Roughness)->Connect(2, TextureSampleNode);
-			CreatedMaterial->GetExpressionInputForProperty(MP_Metallic)->Connect(3, TextureSampleNode);
-			CreatedMaterial->PostEditChange();
+	ParameterNode->Material = Material;
+	ParameterNode->MaterialExpressionEditorX = TextureSampleNode->MaterialExpressionEditorX;
+	ParameterNode->MaterialExpressionEditorY = TextureSampleNode->MaterialExpressionEditorY;
+	ParameterNode->Desc = TextureSampleNode->Desc;
 
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 450;
+	ParameterNode->ParameterName = ParameterName;
+	ParameterNode->ExpressionGUID = FGuid::NewGuid();
+
+	for (UMaterialExpression* Expression : Material->GetExpressions())
+	{
+		if (!Expression) continue;
 
-			return true;
+		for (FExpressionInputIterator It{ Expression }; It; ++It)
+		{
+			if (It.Input->Expression == TextureSampleNode)
+			{
+				It.Input->Expression = ParameterNode;
+			}
 		}
 	}
-	return false;
-}//TryConnectORM.
 
-#pragma endregion
+	for (int32 PropertyIndex = 0; PropertyIndex < MP_MAX; PropertyIndex++)
+	{
+		FExpressionInput* PropertyInput = Material->GetExpressionInputForProperty((EMaterialProperty)PropertyIndex);
 
+		if (PropertyInput && PropertyInput->Expression == TextureSampleNode)
+		{
+			PropertyInput->Expression = ParameterNode;
+		}
+	}
+
+	Material->GetExpressionCollection().AddExpression(ParameterNode);
+	Material->GetExpressionCollection().RemoveExpression(TextureSampleNode);
 
+	return ParameterNode;
+
+}//ConvertTextureSampleToParameter.
 
 UMaterialInstanceConstant* UQuickMaterialWidget::CreateMaterialInstanceAsset(UMaterial* CreatedMaterial, FString NameOfMaterialInstance, const FString& PathToPutMI)
 {
 
-	NameOfMaterialInstance.RemoveFromStart(TEXT("M_"));
-	NameOfMaterialInstance.InsertAt(0, TEXT("MI_"));
+	//Names reserved by a batch job come in with the prefix already.
+	if (!NameOfMaterialInstance.StartsWith(TEXT("MI_")))
+	{
+		NameOfMaterialInstance.RemoveFromStart(TEXT("M_"));
+		NameOfMaterialInstance.InsertAt(0, TEXT("MI_"));
+	}
 
 	UMaterialInstanceConstantFactoryNew* MIFactoryNew = NewObject<UMaterialInstanceConstantFactoryNew>();
 	MIFactoryNew->InitialParent = CreatedMaterial;
@@ -484,7 +1724,6 @@ UMaterialInstanceConstant* UQuickMaterialWidget::CreateMaterialInstanceAsset(UMa
 		//CreatedMI->SetParentEditorOnly(CreatedMaterial);
 
 		//CreatedMI->PostEditChange();
-		CreatedMaterial->PostEditChange();
 
 		return CreatedMI;
 	}
@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/SafeAssetDeleter.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "DebugHeader.h"
+#include "ObjectTools.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "ISourceControlModule.h"
+
+int32 FSafeAssetDeleter::DeleteAssets(const TArray<FAssetData>& AssetsToDelete)
+{
+	TArray<FAssetData> ProvenUnreferenced;
+	TArray<FAssetData> NeedsFullDelete;
+	PartitionProvenUnreferenced(AssetsToDelete, ProvenUnreferenced, NeedsFullDelete);
+
+	int32 NumOfDeletedAssets = 0;
+
+	if (ProvenUnreferenced.Num() > 0)
+	{
+		const EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
+			FString::Printf(TEXT("%d assets are referenced by nothing on disk or in memory and can be deleted without loading them.\nWould you like to delete them?"),
+				ProvenUnreferenced.Num()), false);
+
+		if (ConfirmResult == EAppReturnType::Yes)
+		{
+			TArray<FAssetData> FailedAssets;
+			NumOfDeletedAssets += DeletePackageFiles(ProvenUnreferenced, FailedAssets);
+
+			//A file that would not go away gets a second chance through the regular path.
+			NeedsFullDelete.Append(FailedAssets);
+		}
+		else
+		{
+			//Declining only skips the shortcut, the regular path asks about everything once more.
+			NeedsFullDelete.Append(ProvenUnreferenced);
+		}
+	}
+
+	if (NeedsFullDelete.Num() > 0)
+	{
+		NumOfDeletedAssets += ObjectTools::DeleteAssets(NeedsFullDelete);
+	}
+
+	return NumOfDeletedAssets;
+
+}//DeleteAssets.
+
+void FSafeAssetDeleter::PartitionProvenUnreferenced(const TArray<FAssetData>& AssetsToDelete,
+	TArray<FAssetData>& OutProvenUnreferenced, TArray<FAssetData>& OutNeedsFullDelete)
+{
+	OutProvenUnreferenced.Reset();
+	OutNeedsFullDelete.Reset();
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	//An incomplete registry proves nothing, and deletes under source control have to go through it.
+	if (AssetRegistry.IsLoadingAssets() || ISourceControlModule::Get().IsEnabled())
+	{
+		OutNeedsFullDelete = AssetsToDelete;
+		return;
+	}
+
+	TMap<FName, TArray<int32>> AssetsByPackage;
+
+	for (int32 AssetIndex = 0; AssetIndex < AssetsToDelete.Num(); AssetIndex++)
+	{
+		AssetsByPackage.FindOrAdd(AssetsToDelete[AssetIndex].PackageName).Add(AssetIndex);
+	}
+
+	TSet<FName> ProvenPackages;
+	TMap<FName, TArray<FName>> ReferencersInsideDeletion;
+
+	TArray<FAssetData> PackageAssets;
+	TArray<FName> Referencers;
+
+	for (const TPair<FName, TArray<int32>>& Package : AssetsByPackage)
+	{
+		const FName PackageName = Package.Key;
+
+		//Maps own external actor packages, those are left to the regular path.
+		const bool bContainsMap = Package.Value.ContainsByPredicate([&AssetsToDelete](int32 AssetIndex)
+			{
+				return AssetsToDelete[AssetIndex].AssetClassPath == UWorld::StaticClass()->GetClassPathName();
+			});
+
+		if (bContainsMap) continue;
+
+		//Loaded means something in memory or an open editor may still hold it.
+		if (FindPackage(nullptr, *PackageName.ToString())) continue;
+
+		//Deleting the file takes every asset in it, all of them have to be in the deletion.
+		PackageAssets.Reset();
+		AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssets);
+
+		if (PackageAssets.Num() != Package.Value.Num()) continue;
+
+		FString PackageFilename;
+		if (!FPackageName::DoesPackageExist(PackageName.ToString(), &PackageFilename) ||
+			IFileManager::Get().IsReadOnly(*PackageFilename))
+		{
+			continue;
+		}
+
+		//Every kind of reference counts, not only hard package ones.
+		Referencers.Reset();
+		AssetRegistry.GetReferencers(PackageName, Referencers);
+
+		bool bReferencedFromOutside = false;
+		TArray<FName>& InsideReferencers = ReferencersInsideDeletion.Add(PackageName);
+
+		for (const FName& Referencer : Referencers)
+		{
+			if (Referencer == PackageName) continue;
+
+			if (!AssetsByPackage.Contains(Referencer))
+			{
+				bReferencedFromOutside = true;
+				break;
+			}
+
+			InsideReferencers.Add(Referencer);
+		}
+
+		if (!bReferencedFromOutside)
+		{
+			ProvenPackages.Add(PackageName);
+		}
+	}
+
+	//A package referenced by one that is not proven would be left dangling on disk, drop it too until nothing changes.
+	bool bDroppedPackage = true;
+	while (bDroppedPackage)
+	{
+		bDroppedPackage = false;
+
+		for (auto ProvenIt = ProvenPackages.CreateIterator(); ProvenIt; ++ProvenIt)
+		{
+			for (const FName& Referencer : ReferencersInsideDeletion[*ProvenIt])
+			{
+				if (!ProvenPackages.Contains(Referencer))
+				{
+					ProvenIt.RemoveCurrent();
+					bDroppedPackage = true;
+					break;
+				}
+			}
+		}
+	}
+
+	for (const FAssetData& AssetData : AssetsToDelete)
+	{
+		if (ProvenPackages.Contains(AssetData.PackageName))
+		{
+			OutProvenUnreferenced.Add(AssetData);
+		}
+		else
+		{
+			OutNeedsFullDelete.Add(AssetData);
+		}
+	}
+
+}//PartitionProvenUnreferenced.
+
+int32 FSafeAssetDeleter::DeletePackageFiles(const TArray<FAssetData>& ProvenUnreferenced, TArray<FAssetData>& OutFailed)
+{
+	OutFailed.Reset();
+
+	TMap<FName, bool> PackageDeleted;
+	TArray<FString> DeletedFilenames;
+
+	for (const FAssetData& AssetData : ProvenUnreferenced)
+	{
+		if (PackageDeleted.Contains(AssetData.PackageName)) continue;
+
+		FString PackageFilename;
+		const bool bDeleted = FPackageName::DoesPackageExist(AssetData.PackageName.ToString(), &PackageFilename) &&
+			IFileManager::Get().Delete(*PackageFilename, false, false, true);
+
+		PackageDeleted.Add(AssetData.PackageName, bDeleted);
+
+		if (bDeleted)
+		{
+			DeletedFilenames.Add(PackageFilename);
+			DebugHeader::PrintLog(TEXT("Deleted without loading: ") + PackageFilename);
+		}
+	}
+
+	int32 NumOfDeletedAssets = 0;
+
+	for (const FAssetData& AssetData : ProvenUnreferenced)
+	{
+		if (PackageDeleted[AssetData.PackageName])
+		{
+			++NumOfDeletedAssets;
+		}
+		else
+		{
+			OutFailed.Add(AssetData);
+		}
+	}
+
+	//One rescan of the removed files drops their entries, instead of a registry update per asset.
+	if (DeletedFilenames.Num() > 0)
+	{
+		IAssetRegistry& AssetRegistry =
+			FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+		AssetRegistry.ScanModifiedAssetFiles(DeletedFilenames);
+	}
+
+	return NumOfDeletedAssets;
+
+}//DeletePackageFiles.
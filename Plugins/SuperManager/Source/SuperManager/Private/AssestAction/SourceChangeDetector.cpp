@@ -0,0 +1,172 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/SourceChangeDetector.h"
+#include "Async/ParallelFor.h"
+#include "EditorFramework/AssetImportData.h"
+#include "EditorReimportHandler.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+
+//Same rule the import data uses, relative paths start at the folder of the package file.
+static FString ResolveSourceFilename(const FString& RelativeFilename, FName PackageName)
+{
+	if (!FPaths::IsRelative(RelativeFilename)) return RelativeFilename;
+
+	FString PackageFilename;
+	if (FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), PackageFilename))
+	{
+		const FString NextToPackage = FPaths::ConvertRelativePathToFull(FPaths::GetPath(PackageFilename) / RelativeFilename);
+
+		if (FPaths::FileExists(NextToPackage)) return NextToPackage;
+	}
+
+	return FPaths::ConvertRelativePathToFull(RelativeFilename);
+
+}//ResolveSourceFilename.
+
+FSourceChangeReport FSourceChangeDetector::FindChangedSources(const TArray<FAssetData>& AssetsData)
+{
+	FSourceChangeReport Report;
+
+	//Each source file is hashed once, however many assets were imported from it.
+	TArray<FString> SourceFiles;
+	TMap<FString, int32> SourceFileIndices;
+
+	struct FStoredHash
+	{
+		int32 AssetIndex;
+		int32 SourceFileIndex;
+		FMD5Hash FileHash;
+	};
+	TArray<FStoredHash> StoredHashes;
+
+	for (int32 AssetIndex = 0; AssetIndex < AssetsData.Num(); AssetIndex++)
+	{
+		FString ImportDataJson;
+		if (!AssetsData[AssetIndex].GetTagValue(UObject::SourceFileTagName(), ImportDataJson)) continue;
+
+		const TOptional<FAssetImportInfo> ImportInfo = FAssetImportInfo::FromJson(ImportDataJson);
+		if (!ImportInfo.IsSet() || ImportInfo->SourceFiles.Num() == 0) continue;
+
+		bool bHasStoredHash = false;
+
+		for (const FAssetImportInfo::FSourceFile& SourceFile : ImportInfo->SourceFiles)
+		{
+			if (!SourceFile.FileHash.IsValid() || SourceFile.RelativeFilename.IsEmpty()) continue;
+
+			const FString SourceFilename = ResolveSourceFilename(SourceFile.RelativeFilename, AssetsData[AssetIndex].PackageName);
+
+			int32* FoundFileIndex = SourceFileIndices.Find(SourceFilename);
+			const int32 SourceFileIndex = FoundFileIndex ? *FoundFileIndex : SourceFileIndices.Add(SourceFilename, SourceFiles.Add(SourceFilename));
+
+			StoredHashes.Add({ AssetIndex, SourceFileIndex, SourceFile.FileHash });
+			bHasStoredHash = true;
+		}
+
+		if (bHasStoredHash)
+		{
+			++Report.NumOfCheckedAssets;
+		}
+		else
+		{
+			++Report.NumOfUnhashedAssets;
+		}
+	}
+
+	FScopedSlowTask HashTask(1.f, FText::FromString(FString::Printf(TEXT("Hashing %d source files"), SourceFiles.Num())));
+	HashTask.MakeDialog();
+	HashTask.EnterProgressFrame();
+
+	//Invalid hash means the file could not be opened.
+	TArray<FMD5Hash> CurrentHashes;
+	CurrentHashes.SetNum(SourceFiles.Num());
+
+	ParallelFor(SourceFiles.Num(), [&SourceFiles, &CurrentHashes](int32 SourceFileIndex)
+		{
+			TUniquePtr<FArchive> SourceReader(IFileManager::Get().CreateFileReader(*SourceFiles[SourceFileIndex], FILEREAD_Silent));
+			if (!SourceReader) return;
+
+			//Streams the file through a fixed buffer, large sources are never held in memory whole.
+			TArray<uint8> ReadBuffer;
+			CurrentHashes[SourceFileIndex] = FMD5Hash::HashFileFromArchive(SourceReader.Get(), &ReadBuffer);
+		},
+		EParallelForFlags::Unbalanced);
+
+	Report.NumOfHashedFiles = SourceFiles.Num();
+
+	for (int32 SourceFileIndex = 0; SourceFileIndex < SourceFiles.Num(); SourceFileIndex++)
+	{
+		if (!CurrentHashes[SourceFileIndex].IsValid())
+		{
+			Report.MissingSourceFiles.Add(SourceFiles[SourceFileIndex]);
+		}
+	}
+
+	TBitArray<> IsChanged(false, AssetsData.Num());
+
+	for (const FStoredHash& StoredHash : StoredHashes)
+	{
+		const FMD5Hash& CurrentHash = CurrentHashes[StoredHash.SourceFileIndex];
+
+		//A missing source cannot be reimported, it is only reported.
+		if (CurrentHash.IsValid() && CurrentHash != StoredHash.FileHash)
+		{
+			IsChanged[StoredHash.AssetIndex] = true;
+		}
+	}
+
+	for (TConstSetBitIterator<> BitIt(IsChanged); BitIt; ++BitIt)
+	{
+		Report.ChangedAssets.Add(AssetsData[BitIt.GetIndex()]);
+	}
+
+	return Report;
+
+}//FindChangedSources.
+
+int32 FSourceChangeDetector::ReimportInBatches(const TArray<FAssetData>& AssetsToReimport, int32 BatchSize)
+{
+	int32 NumOfReimportedAssets = 0;
+
+	FScopedSlowTask ReimportTask((float)AssetsToReimport.Num(), FText::FromString(TEXT("Reimporting changed assets")));
+	ReimportTask.MakeDialog(true);
+
+	for (int32 BatchStart = 0; BatchStart < AssetsToReimport.Num(); BatchStart += BatchSize)
+	{
+		if (ReimportTask.ShouldCancel()) break;
+
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, AssetsToReimport.Num());
+
+		TArray<UPackage*> PackagesToSave;
+
+		for (int32 AssetIndex = BatchStart; AssetIndex < BatchEnd; AssetIndex++)
+		{
+			ReimportTask.EnterProgressFrame(1.f, FText::FromString(AssetsToReimport[AssetIndex].AssetName.ToString()));
+
+			UObject* AssetToReimport = AssetsToReimport[AssetIndex].GetAsset();
+			if (!AssetToReimport) continue;
+
+			//Automated, a failing source shows in the log instead of a file dialog per asset.
+			if (FReimportManager::Instance()->Reimport(AssetToReimport, false, false, TEXT(""), nullptr, INDEX_NONE, false, true))
+			{
+				PackagesToSave.Add(AssetToReimport->GetPackage());
+				++NumOfReimportedAssets;
+			}
+		}
+
+		if (PackagesToSave.Num() > 0)
+		{
+			UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+		}
+
+		//Saved, so the batch can be unloaded before the next one comes in.
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	return NumOfReimportedAssets;
+
+}//ReimportInBatches.
@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/TextureChannelPacker.h"
+#include "Engine/Texture2D.h"
+#include "ImageCore.h"
+#include "Async/ParallelFor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#include <arm_neon.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+#include <emmintrin.h>
+#endif
+
+bool FTextureChannelPacker::ReadSourceAsGray8(UTexture2D* SourceTexture, TArray64<uint8>& OutPixels, int32& OutSizeX, int32& OutSizeY)
+{
+	if (!SourceTexture || !SourceTexture->Source.IsValid()) return false;
+
+	FImage SourceImage;
+	if (!SourceTexture->Source.GetMipImage(SourceImage, 0, 0, 0)) return false;
+
+	//Data maps are packed as authored, even if the source was imported as sRGB by mistake.
+	SourceImage.GammaSpace = EGammaSpace::Linear;
+
+	FImage GrayImage;
+	SourceImage.CopyTo(GrayImage, ERawImageFormat::G8, EGammaSpace::Linear);
+
+	OutSizeX = GrayImage.SizeX;
+	OutSizeY = GrayImage.SizeY;
+	OutPixels = MoveTemp(GrayImage.RawData);
+
+	return OutPixels.Num() == (int64)OutSizeX * OutSizeY;
+
+}//ReadSourceAsGray8.
+
+void FTextureChannelPacker::InterleaveORM(const uint8* OcclusionPixels, const uint8* RoughnessPixels, const uint8* MetallicPixels,
+	int32 SizeX, int32 SizeY, TArray64<uint8>& OutBGRA8Pixels)
+{
+	OutBGRA8Pixels.SetNumUninitialized((int64)SizeX * SizeY * 4);
+
+	const int32 NumOfBands = FMath::DivideAndRoundUp(SizeY, RowsPerBand);
+
+	ParallelFor(NumOfBands, [&](int32 BandIndex)
+	{
+		const int32 BandStartRow = BandIndex * RowsPerBand;
+		const int32 BandEndRow = FMath::Min(BandStartRow + RowsPerBand, SizeY);
+
+		for (int32 Row = BandStartRow; Row < BandEndRow; Row++)
+		{
+			const int64 RowOffset = (int64)Row * SizeX;
+
+			InterleaveRow(OcclusionPixels + RowOffset, RoughnessPixels + RowOffset, MetallicPixels + RowOffset,
+				OutBGRA8Pixels.GetData() + RowOffset * 4, SizeX);
+		}
+	});
+
+}//InterleaveORM.
+
+void FTextureChannelPacker::InterleaveRow(const uint8* OcclusionRow, const uint8* RoughnessRow, const uint8* MetallicRow,
+	uint8* OutRow, int32 NumOfPixels)
+{
+	int32 PixelIndex = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+
+	const uint8x16_t Alpha = vdupq_n_u8(0xFF);
+
+	for (; PixelIndex + 16 <= NumOfPixels; PixelIndex += 16)
+	{
+		uint8x16x4_t Pixels;
+		Pixels.val[0] = vld1q_u8(MetallicRow + PixelIndex);
+		Pixels.val[1] = vld1q_u8(RoughnessRow + PixelIndex);
+		Pixels.val[2] = vld1q_u8(OcclusionRow + PixelIndex);
+		Pixels.val[3] = Alpha;
+
+		vst4q_u8(OutRow + PixelIndex * 4, Pixels);
+	}
+
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+
+	const __m128i Alpha = _mm_set1_epi8((char)0xFF);
+
+	for (; PixelIndex + 16 <= NumOfPixels; PixelIndex += 16)
+	{
+		const __m128i Blue = _mm_loadu_si128((const __m128i*)(MetallicRow + PixelIndex));
+		const __m128i Green = _mm_loadu_si128((const __m128i*)(RoughnessRow + PixelIndex));
+		const __m128i Red = _mm_loadu_si128((const __m128i*)(OcclusionRow + PixelIndex));
+
+		const __m128i BlueGreenLow = _mm_unpacklo_epi8(Blue, Green);
+		const __m128i BlueGreenHigh = _mm_unpackhi_epi8(Blue, Green);
+		const __m128i RedAlphaLow = _mm_unpacklo_epi8(Red, Alpha);
+		const __m128i RedAlphaHigh = _mm_unpackhi_epi8(Red, Alpha);
+
+		__m128i* OutPixels = (__m128i*)(OutRow + PixelIndex * 4);
+		_mm_storeu_si128(OutPixels + 0, _mm_unpacklo_epi16(BlueGreenLow, RedAlphaLow));
+		_mm_storeu_si128(OutPixels + 1, _mm_unpackhi_epi16(BlueGreenLow, RedAlphaLow));
+		_mm_storeu_si128(OutPixels + 2, _mm_unpacklo_epi16(BlueGreenHigh, RedAlphaHigh));
+		_mm_storeu_si128(OutPixels + 3, _mm_unpackhi_epi16(BlueGreenHigh, RedAlphaHigh));
+	}
+
+#endif
+
+	//Scalar tail, and the whole row on targets without vector intrinsics.
+	for (; PixelIndex < NumOfPixels; PixelIndex++)
+	{
+		uint8* OutPixel = OutRow + PixelIndex * 4;
+		OutPixel[0] = MetallicRow[PixelIndex];
+		OutPixel[1] = RoughnessRow[PixelIndex];
+		OutPixel[2] = OcclusionRow[PixelIndex];
+		OutPixel[3] = 0xFF;
+	}
+
+}//InterleaveRow.
+
+UTexture2D* FTextureChannelPacker::CreatePackedTexture(const FString& TextureName, const FString& PackagePath,
+	int32 SizeX, int32 SizeY, const TArray64<uint8>& BGRA8Pixels)
+{
+	UPackage* TexturePackage = CreatePackage(*(PackagePath / TextureName));
+	if (!TexturePackage) return nullptr;
+
+	UTexture2D* PackedTexture = NewObject<UTexture2D>(TexturePackage, *TextureName, RF_Public | RF_Standalone | RF_Transactional);
+
+	PackedTexture->Source.Init(SizeX, SizeY, 1, 1, TSF_BGRA8, BGRA8Pixels.GetData());
+	PackedTexture->CompressionSettings = TextureCompressionSettings::TC_Masks;
+	PackedTexture->SRGB = false;
+	PackedTexture->PostEditChange();
+
+	FAssetRegistryModule::AssetCreated(PackedTexture);
+	PackedTexture->MarkPackageDirty();
+
+	return PackedTexture;
+
+}//CreatePackedTexture.
@@ -0,0 +1,204 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/TextureMemoryAudit.h"
+#include "AssestAction/TextureSettingsBatch.h"
+#include "Engine/Texture.h"
+#include "Misc/ScopedSlowTask.h"
+#include "FileHelpers.h"
+#include "DebugHeader.h"
+
+//Mips at or below this size stay resident when a texture streams, about the engine's default minimum resident mips.
+static constexpr int32 ResidentMipTailSize = 64;
+
+bool FTextureMemoryAudit::EstimateFromTags(const FAssetData& AssetData, int32 MaxRecommendedSize, FTextureMemoryEstimate& OutEstimate)
+{
+	FString Dimensions;
+	if (!AssetData.GetTagValue(FName("Dimensions"), Dimensions)) return false;
+
+	FString SizeXString, SizeYString;
+	if (!Dimensions.Split(TEXT("x"), &SizeXString, &SizeYString)) return false;
+
+	OutEstimate = FTextureMemoryEstimate();
+	OutEstimate.SizeX = FCString::Atoi(*SizeXString);
+	OutEstimate.SizeY = FCString::Atoi(*SizeYString);
+
+	if (OutEstimate.SizeX <= 0 || OutEstimate.SizeY <= 0) return false;
+
+	FString TagValue;
+	const bool bHasAlpha = AssetData.GetTagValue(FName("HasAlphaChannel"), TagValue) && TagValue.ToBool();
+	const bool bNeverStream = AssetData.GetTagValue(FName("NeverStream"), TagValue) && TagValue.ToBool();
+	const bool bNoMips = AssetData.GetTagValue(FName("MipGenSettings"), TagValue) && TagValue == TEXT("TMGS_NoMipmaps");
+	const bool bIsUserInterface = AssetData.GetTagValue(FName("LODGroup"), TagValue) && TagValue == TEXT("TEXTUREGROUP_UI");
+	const int32 MaxTextureSize = AssetData.GetTagValue(FName("MaxTextureSize"), TagValue) ? FCString::Atoi(*TagValue) : 0;
+	const int32 LODBias = AssetData.GetTagValue(FName("LODBias"), TagValue) ? FMath::Max(FCString::Atoi(*TagValue), 0) : 0;
+
+	FString CompressionName;
+	AssetData.GetTagValue(FName("CompressionSettings"), CompressionName);
+	const int32 BitsPerPixel = GetBitsPerPixel(CompressionName, bHasAlpha);
+
+	const bool bIsPowerOfTwo = FMath::IsPowerOfTwo(OutEstimate.SizeX) && FMath::IsPowerOfTwo(OutEstimate.SizeY);
+
+	//Size as cooked, max texture size first, then the LOD bias drops whole mips.
+	auto GetCookedSize = [&OutEstimate, LODBias](int32 SizeLimit, int32& OutSizeX, int32& OutSizeY)
+		{
+			OutSizeX = OutEstimate.SizeX;
+			OutSizeY = OutEstimate.SizeY;
+
+			while (SizeLimit > 0 && FMath::Max(OutSizeX, OutSizeY) > SizeLimit)
+			{
+				OutSizeX = FMath::Max(OutSizeX / 2, 1);
+				OutSizeY = FMath::Max(OutSizeY / 2, 1);
+			}
+
+			OutSizeX = FMath::Max(OutSizeX >> LODBias, 1);
+			OutSizeY = FMath::Max(OutSizeY >> LODBias, 1);
+		};
+
+	auto GetMemory = [BitsPerPixel, bIsPowerOfTwo](int32 SizeX, int32 SizeY, bool bHasMips, bool bAllowStreaming, int64& OutResident, int64& OutStreaming)
+		{
+			//Textures without mips or with sides that are not powers of two never stream.
+			const bool bStreams = bAllowStreaming && bHasMips && bIsPowerOfTwo;
+			const int64 FullChainBytes = GetMipChainBytes(SizeX, SizeY, BitsPerPixel, bHasMips, MAX_int32);
+
+			OutResident = bStreams ? GetMipChainBytes(SizeX, SizeY, BitsPerPixel, bHasMips, ResidentMipTailSize) : FullChainBytes;
+			OutStreaming = bStreams ? FullChainBytes - OutResident : 0;
+		};
+
+	int32 CookedSizeX, CookedSizeY;
+	GetCookedSize(MaxTextureSize, CookedSizeX, CookedSizeY);
+	GetMemory(CookedSizeX, CookedSizeY, !bNoMips, !bNeverStream, OutEstimate.ResidentBytes, OutEstimate.StreamingBytes);
+
+	if (!bIsPowerOfTwo) OutEstimate.Flags |= ETextureAuditFlags::NonPowerOfTwo;
+	if (FMath::Max(CookedSizeX, CookedSizeY) > MaxRecommendedSize) OutEstimate.Flags |= ETextureAuditFlags::Oversized;
+
+	//UI textures are drawn at a fixed size, no mips and no streaming is what they should have.
+	if (!bIsUserInterface)
+	{
+		if (bNeverStream) OutEstimate.Flags |= ETextureAuditFlags::NeverStream;
+		if (bNoMips) OutEstimate.Flags |= ETextureAuditFlags::NoMips;
+	}
+
+	//Same texture with the fixes ApplyFixes would make.
+	int32 FixedSizeX, FixedSizeY;
+	GetCookedSize(EnumHasAnyFlags(OutEstimate.Flags, ETextureAuditFlags::Oversized) ? MaxRecommendedSize : MaxTextureSize,
+		FixedSizeX, FixedSizeY);
+
+	int64 FixedResidentBytes, FixedStreamingBytes;
+	GetMemory(FixedSizeX, FixedSizeY, !bNoMips || !bIsUserInterface, !bNeverStream || !bIsUserInterface,
+		FixedResidentBytes, FixedStreamingBytes);
+
+	OutEstimate.SavedBytes = FMath::Max<int64>(OutEstimate.ResidentBytes - FixedResidentBytes, 0) +
+		FMath::Max<int64>(OutEstimate.StreamingBytes - FixedStreamingBytes, 0);
+
+	return true;
+
+}//EstimateFromTags.
+
+TArray<FName> FTextureMemoryAudit::ApplyFixes(const TArray<FAssetData>& TexturesData, int32 MaxRecommendedSize)
+{
+	FTextureSettingsBatch SettingsBatch;
+
+	FScopedSlowTask FixTask((float)TexturesData.Num(), FText::FromString(TEXT("Fixing texture settings")));
+	FixTask.MakeDialog(true);
+
+	for (const FAssetData& TextureData : TexturesData)
+	{
+		if (FixTask.ShouldCancel()) break;
+
+		FixTask.EnterProgressFrame(1.f, FText::FromString(TextureData.AssetName.ToString()));
+
+		FTextureMemoryEstimate Estimate;
+		if (!EstimateFromTags(TextureData, MaxRecommendedSize, Estimate) || Estimate.Flags == ETextureAuditFlags::None) continue;
+
+		UTexture* Texture = Cast<UTexture>(TextureData.GetAsset());
+		if (!Texture) continue;
+
+		SettingsBatch.AddStreamingFix(Texture,
+			EnumHasAnyFlags(Estimate.Flags, ETextureAuditFlags::Oversized) ? MaxRecommendedSize : 0,
+			EnumHasAnyFlags(Estimate.Flags, ETextureAuditFlags::NeverStream),
+			EnumHasAnyFlags(Estimate.Flags, ETextureAuditFlags::NoMips));
+	}
+
+	TArray<UPackage*> PackagesToSave;
+	for (UTexture* FixedTexture : SettingsBatch.Apply())
+	{
+		PackagesToSave.AddUnique(FixedTexture->GetPackage());
+	}
+
+	//The audit reads registry tags, which only change once the package is written.
+	if (PackagesToSave.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	}
+
+	//A package left dirty failed to save, its texture would be listed again and is not reported as fixed.
+	TArray<FName> FixedPackageNames;
+	for (UPackage* SavedPackage : PackagesToSave)
+	{
+		if (SavedPackage->IsDirty())
+		{
+			DebugHeader::PrintLog(TEXT("Failed to save fixed texture ") + SavedPackage->GetName());
+			continue;
+		}
+
+		FixedPackageNames.Add(SavedPackage->GetFName());
+	}
+
+	return FixedPackageNames;
+
+}//ApplyFixes.
+
+FString FTextureMemoryAudit::DescribeFlags(ETextureAuditFlags Flags)
+{
+	TArray<FString> FlagNames;
+
+	if (EnumHasAnyFlags(Flags, ETextureAuditFlags::Oversized)) FlagNames.Add(TEXT("Oversized"));
+	if (EnumHasAnyFlags(Flags, ETextureAuditFlags::NeverStream)) FlagNames.Add(TEXT("Never Stream"));
+	if (EnumHasAnyFlags(Flags, ETextureAuditFlags::NoMips)) FlagNames.Add(TEXT("No Mips"));
+	if (EnumHasAnyFlags(Flags, ETextureAuditFlags::NonPowerOfTwo)) FlagNames.Add(TEXT("Not Power Of Two"));
+
+	return FString::Join(FlagNames, TEXT(", "));
+
+}//DescribeFlags.
+
+int32 FTextureMemoryAudit::GetBitsPerPixel(const FString& CompressionName, bool bHasAlpha)
+{
+	//Formats the default desktop texture format picks for each compression setting.
+	if (CompressionName.IsEmpty() || CompressionName == TEXT("TC_Default") || CompressionName == TEXT("TC_Masks"))
+	{
+		return bHasAlpha ? 8 : 4;
+	}
+
+	if (CompressionName == TEXT("TC_Alpha")) return 4;
+	if (CompressionName == TEXT("TC_LQ") || CompressionName == TEXT("TC_HalfFloat")) return 16;
+	if (CompressionName == TEXT("TC_VectorDisplacementmap") || CompressionName == TEXT("TC_EditorIcon") ||
+		CompressionName == TEXT("TC_SingleFloat") || CompressionName == TEXT("TC_EncodedReflectionCapture")) return 32;
+	if (CompressionName == TEXT("TC_HDR")) return 64;
+	if (CompressionName == TEXT("TC_HDR_F32")) return 128;
+
+	//Normal maps, grayscale, BC7, compressed HDR and distance field fonts.
+	return 8;
+
+}//GetBitsPerPixel.
+
+int64 FTextureMemoryAudit::GetMipChainBytes(int32 SizeX, int32 SizeY, int32 BitsPerPixel, bool bHasMips, int32 LargestMipSize)
+{
+	int64 ChainBytes = 0;
+
+	while (true)
+	{
+		if (FMath::Max(SizeX, SizeY) <= LargestMipSize)
+		{
+			ChainBytes += (int64)SizeX * SizeY * BitsPerPixel / 8;
+		}
+
+		if (!bHasMips || (SizeX == 1 && SizeY == 1)) break;
+
+		SizeX = FMath::Max(SizeX / 2, 1);
+		SizeY = FMath::Max(SizeY / 2, 1);
+	}
+
+	return ChainBytes;
+
+}//GetMipChainBytes.
@@ -0,0 +1,219 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/TextureRoleAnalyzer.h"
+#include "Engine/Texture2D.h"
+#include "ImageCore.h"
+#include "Async/ParallelFor.h"
+
+bool FTextureRoleAnalyzer::ReadSamples(UTexture2D* Texture, TArray<FColor>& OutSamples)
+{
+	OutSamples.Reset();
+
+	if (!Texture || !Texture->Source.IsValid()) return false;
+
+	//Imported sources usually carry one mip, but use a smaller one when it exists.
+	int32 MipIndex = 0;
+	while (MipIndex + 1 < Texture->Source.GetNumMips() &&
+		FMath::Min(Texture->Source.GetSizeX(), Texture->Source.GetSizeY()) >> (MipIndex + 1) >= SampleGridSize)
+	{
+		MipIndex++;
+	}
+
+	//A read only lock views the stored mip in its own format, nothing is copied or converted as a whole.
+	FTextureSource::FMipLock MipLock(FTextureSource::ELockState::ReadOnly, &Texture->Source, 0, 0, MipIndex);
+	if (!MipLock.IsValid()) return false;
+
+	FImageView MipImage = MipLock.Image;
+	if (MipImage.SizeX <= 0 || MipImage.SizeY <= 0) return false;
+
+	//Statistics are taken on the stored values, the sRGB flag is what is being checked.
+	MipImage.GammaSpace = EGammaSpace::Linear;
+
+	const int32 GridSizeX = FMath::Min(SampleGridSize, MipImage.SizeX);
+	const int32 GridSizeY = FMath::Min(SampleGridSize, MipImage.SizeY);
+
+	OutSamples.SetNumUninitialized(GridSizeX * GridSizeY);
+
+	for (int32 GridY = 0; GridY < GridSizeY; GridY++)
+	{
+		const int32 PixelY = (int32)(((int64)GridY * MipImage.SizeY + MipImage.SizeY / 2) / GridSizeY);
+
+		for (int32 GridX = 0; GridX < GridSizeX; GridX++)
+		{
+			const int32 PixelX = (int32)(((int64)GridX * MipImage.SizeX + MipImage.SizeX / 2) / GridSizeX);
+
+			OutSamples[GridY * GridSizeX + GridX] = MipImage.GetOnePixelLinear(PixelX, PixelY).ToFColor(false);
+		}
+	}
+
+	return true;
+
+}//ReadSamples.
+
+void FTextureRoleAnalyzer::ReadSampleSets(const TArray<UTexture2D*>& Textures, TArray<TArray<FColor>>& OutSampleSets)
+{
+	OutSampleSets.Reset();
+	OutSampleSets.SetNum(Textures.Num());
+
+	//Each read holds at most one decompressed mip, the chunks bound how many are alive at once.
+	const int32 MaxConcurrentReads = FMath::Max(FPlatformMisc::NumberOfCores(), 1);
+
+	for (int32 ChunkStart = 0; ChunkStart < Textures.Num(); ChunkStart += MaxConcurrentReads)
+	{
+		const int32 ChunkSize = FMath::Min(MaxConcurrentReads, Textures.Num() - ChunkStart);
+
+		ParallelFor(ChunkSize, [&Textures, &OutSampleSets, ChunkStart](int32 ChunkIndex)
+		{
+			const int32 TextureIndex = ChunkStart + ChunkIndex;
+			ReadSamples(Textures[TextureIndex], OutSampleSets[TextureIndex]);
+		},
+		EParallelForFlags::Unbalanced);
+	}
+
+}//ReadSampleSets.
+
+FTextureRoleAnalysis FTextureRoleAnalyzer::AnalyzeSamples(TConstArrayView<FColor> Samples)
+{
+	FTextureRoleAnalysis Analysis;
+
+	if (Samples.Num() == 0) return Analysis;
+
+	const VectorRegister4Float ByteToUnit = VectorSetFloat1(1.f / 255.f);
+	const VectorRegister4Float One = VectorOneFloat();
+	const VectorRegister4Float Two = VectorSetFloat1(2.f);
+
+	VectorRegister4Float ChannelSum = VectorZeroFloat();
+	VectorRegister4Float ChromaSum = VectorZeroFloat();
+	VectorRegister4Float NormalErrorSum = VectorZeroFloat();
+
+	uint32 LuminanceHistogram[HistogramBins] = {};
+
+	for (const FColor& Sample : Samples)
+	{
+		//Lanes hold B, G, R, A as laid out in memory.
+		const VectorRegister4Float Color = VectorMultiply(VectorLoadByte4(&Sample), ByteToUnit);
+
+		ChannelSum = VectorAdd(ChannelSum, Color);
+
+		//|B - G|, |G - R|, |R - B| in the first three lanes.
+		ChromaSum = VectorAdd(ChromaSum, VectorAbs(VectorSubtract(Color, VectorSwizzle(Color, 1, 2, 0, 3))));
+
+		const VectorRegister4Float Direction = VectorSubtract(VectorMultiply(Color, Two), One);
+		NormalErrorSum = VectorAdd(NormalErrorSum, VectorAbs(VectorSubtract(VectorDot3(Direction, Direction), One)));
+
+		LuminanceHistogram[(Sample.R * 3 + Sample.G * 6 + Sample.B) * HistogramBins / 2560]++;
+	}
+
+	alignas(16) float ChannelTotals[4];
+	alignas(16) float ChromaTotals[4];
+	alignas(16) float NormalErrorTotals[4];
+	VectorStoreAligned(ChannelSum, ChannelTotals);
+	VectorStoreAligned(ChromaSum, ChromaTotals);
+	VectorStoreAligned(NormalErrorSum, NormalErrorTotals);
+
+	const float InvNumOfSamples = 1.f / Samples.Num();
+	const float MeanBlue = ChannelTotals[0] * InvNumOfSamples;
+	const float MeanGreen = ChannelTotals[1] * InvNumOfSamples;
+	const float MeanRed = ChannelTotals[2] * InvNumOfSamples;
+
+	Analysis.NormalLengthError = NormalErrorTotals[0] * InvNumOfSamples;
+	Analysis.Chroma = (ChromaTotals[0] + ChromaTotals[1] + ChromaTotals[2]) * InvNumOfSamples / 3.f;
+	Analysis.MeanLuminance = 0.3f * MeanRed + 0.6f * MeanGreen + 0.1f * MeanBlue;
+	Analysis.ExtremeFraction = (LuminanceHistogram[0] + LuminanceHistogram[HistogramBins - 1]) * InvNumOfSamples;
+
+	const bool bLooksLikeNormal = Analysis.NormalLengthError < 0.15f && MeanBlue > 0.7f &&
+		FMath::Abs(MeanRed - 0.5f) < 0.15f && FMath::Abs(MeanGreen - 0.5f) < 0.15f;
+
+	if (bLooksLikeNormal)
+	{
+		Analysis.Role = ETextureRole::Normal;
+	}
+	else if (Analysis.Chroma < 0.02f)
+	{
+		//Grayscale data, metal masks are mostly black or white and occlusion is mostly bright.
+		if (Analysis.ExtremeFraction > 0.85f)
+		{
+			Analysis.Role = ETextureRole::Metallic;
+		}
+		else if (Analysis.MeanLuminance > 0.7f)
+		{
+			Analysis.Role = ETextureRole::AmbientOcclusion;
+		}
+		else
+		{
+			Analysis.Role = ETextureRole::Roughness;
+		}
+	}
+	else
+	{
+		Analysis.Role = ETextureRole::BaseColor;
+	}
+
+	Analysis.bIsValid = true;
+	return Analysis;
+
+}//AnalyzeSamples.
+
+void FTextureRoleAnalyzer::AnalyzeSampleSets(const TArray<TArray<FColor>>& SampleSets, TArray<FTextureRoleAnalysis>& OutAnalyses)
+{
+	OutAnalyses.SetNum(SampleSets.Num());
+
+	ParallelFor(SampleSets.Num(), [&](int32 SetIndex)
+	{
+		OutAnalyses[SetIndex] = AnalyzeSamples(SampleSets[SetIndex]);
+	});
+
+}//AnalyzeSampleSets.
+
+bool FTextureRoleAnalyzer::IsNameRoleConsistent(ETextureRole NameRole, const FTextureRoleAnalysis& Analysis)
+{
+	if (!Analysis.bIsValid) return true;
+
+	switch (NameRole)
+	{
+	case ETextureRole::Normal:
+		return Analysis.Role == ETextureRole::Normal;
+
+	//Which grayscale role it is can only be guessed, any grayscale result agrees with the name.
+	case ETextureRole::Metallic:
+	case ETextureRole::Roughness:
+	case ETextureRole::AmbientOcclusion:
+		return Analysis.Role == ETextureRole::Metallic || Analysis.Role == ETextureRole::Roughness ||
+			Analysis.Role == ETextureRole::AmbientOcclusion;
+
+	case ETextureRole::BaseColor:
+		return Analysis.Role != ETextureRole::Normal;
+
+	default:
+		return true;
+	}
+
+}//IsNameRoleConsistent.
+
+//Same settings the material pins are wired with.
+void FTextureRoleAnalyzer::GetSuggestedSettings(ETextureRole Role, TextureCompressionSettings& OutCompression, bool& bOutSRGB)
+{
+	switch (Role)
+	{
+	case ETextureRole::Normal:
+		OutCompression = TextureCompressionSettings::TC_Normalmap;
+		bOutSRGB = false;
+		break;
+	case ETextureRole::ORM:
+		OutCompression = TextureCompressionSettings::TC_Masks;
+		bOutSRGB = false;
+		break;
+	case ETextureRole::Metallic:
+	case ETextureRole::Roughness:
+	case ETextureRole::AmbientOcclusion:
+		OutCompression = TextureCompressionSettings::TC_Default;
+		bOutSRGB = false;
+		break;
+	default:
+		OutCompression = TextureCompressionSettings::TC_Default;
+		bOutSRGB = true;
+		break;
+	}
+
+}//GetSuggestedSettings.
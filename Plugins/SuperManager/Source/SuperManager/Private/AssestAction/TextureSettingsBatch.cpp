@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/TextureSettingsBatch.h"
+#include "Engine/Texture.h"
+#include "TextureCompiler.h"
+#include "Containers/Ticker.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Framework/Notifications/NotificationManager.h"
+
+bool FTextureSettingsBatch::Add(UTexture* Texture, TextureCompressionSettings Compression, bool bSRGB)
+{
+	if (!Texture) return false;
+
+	FPendingTextureSettings Settings;
+	Settings.Compression = Compression;
+	Settings.bSRGB = bSRGB;
+
+	if (Settings.IsAppliedTo(Texture) && !PendingSettings.Contains(Texture))
+	{
+		return false;
+	}
+
+	FPendingTextureSettings& QueuedSettings = FindOrAddSettings(Texture);
+	QueuedSettings.Compression = Compression;
+	QueuedSettings.bSRGB = bSRGB;
+
+	return true;
+
+}//Add.
+
+bool FTextureSettingsBatch::AddStreamingFix(UTexture* Texture, int32 MaxTextureSize, bool bEnableStreaming, bool bGenerateMips)
+{
+	if (!Texture) return false;
+
+	FPendingTextureSettings Settings;
+	if (MaxTextureSize > 0) Settings.MaxTextureSize = MaxTextureSize;
+	if (bEnableStreaming) Settings.bNeverStream = false;
+	if (bGenerateMips) Settings.MipGenSettings = TextureMipGenSettings::TMGS_FromTextureGroup;
+
+	if (Settings.IsAppliedTo(Texture)) return false;
+
+	FPendingTextureSettings& QueuedSettings = FindOrAddSettings(Texture);
+	if (Settings.MaxTextureSize.IsSet()) QueuedSettings.MaxTextureSize = Settings.MaxTextureSize;
+	if (Settings.bNeverStream.IsSet()) QueuedSettings.bNeverStream = Settings.bNeverStream;
+	if (Settings.MipGenSettings.IsSet()) QueuedSettings.MipGenSettings = Settings.MipGenSettings;
+
+	return true;
+
+}//AddStreamingFix.
+
+TArray<UTexture*> FTextureSettingsBatch::Apply()
+{
+	TArray<UTexture*> ChangedTextures;
+
+	for (const TPair<TObjectKey<UTexture>, FPendingTextureSettings>& PendingPair : PendingSettings)
+	{
+		const FPendingTextureSettings& Settings = PendingPair.Value;
+		UTexture* Texture = Settings.Texture.Get();
+
+		if (!Texture || Settings.IsAppliedTo(Texture)) continue;
+
+		Texture->Modify();
+
+		if (Settings.Compression.IsSet()) Texture->CompressionSettings = Settings.Compression.GetValue();
+		if (Settings.bSRGB.IsSet()) Texture->SRGB = Settings.bSRGB.GetValue();
+		if (Settings.MaxTextureSize.IsSet()) Texture->MaxTextureSize = Settings.MaxTextureSize.GetValue();
+		if (Settings.bNeverStream.IsSet()) Texture->NeverStream = Settings.bNeverStream.GetValue();
+		if (Settings.MipGenSettings.IsSet()) Texture->MipGenSettings = Settings.MipGenSettings.GetValue();
+
+		//With async texture compilation this only queues the rebuild.
+		Texture->PostEditChange();
+
+		ChangedTextures.Add(Texture);
+	}
+
+	PendingSettings.Empty();
+
+	if (ChangedTextures.Num() > 0)
+	{
+		ShowCompileProgress(ChangedTextures.Num());
+	}
+
+	return ChangedTextures;
+
+}//Apply.
+
+bool FTextureSettingsBatch::FPendingTextureSettings::IsAppliedTo(const UTexture* InTexture) const
+{
+	return (!Compression.IsSet() || InTexture->CompressionSettings == Compression.GetValue()) &&
+		(!bSRGB.IsSet() || InTexture->SRGB == bSRGB.GetValue()) &&
+		(!MaxTextureSize.IsSet() || InTexture->MaxTextureSize == MaxTextureSize.GetValue()) &&
+		(!bNeverStream.IsSet() || (bool)InTexture->NeverStream == bNeverStream.GetValue()) &&
+		(!MipGenSettings.IsSet() || InTexture->MipGenSettings == MipGenSettings.GetValue());
+
+}//IsAppliedTo.
+
+FTextureSettingsBatch::FPendingTextureSettings& FTextureSettingsBatch::FindOrAddSettings(UTexture* Texture)
+{
+	FPendingTextureSettings& Settings = PendingSettings.FindOrAdd(Texture);
+	Settings.Texture = Texture;
+
+	return Settings;
+
+}//FindOrAddSettings.
+
+void FTextureSettingsBatch::ShowCompileProgress(int32 NumOfChangedTextures)
+{
+	FNotificationInfo NotifyInfo(FText::FromString(FString::Printf(TEXT("Rebuilding %d textures"), NumOfChangedTextures)));
+	NotifyInfo.bFireAndForget = false;
+	NotifyInfo.FadeOutDuration = 3.f;
+
+	TSharedPtr<SNotificationItem> NotifyItem = FSlateNotificationManager::Get().AddNotification(NotifyInfo);
+
+	if (!NotifyItem.IsValid()) return;
+
+	NotifyItem->SetCompletionState(SNotificationItem::CS_Pending);
+
+	const double RebuildStartTime = FPlatformTime::Seconds();
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+		[NotifyItem, NumOfChangedTextures, RebuildStartTime](float DeltaTime)
+		{
+			const int32 NumOfRemainingTextures = FTextureCompilingManager::Get().GetNumRemainingTextures();
+
+			if (NumOfRemainingTextures > 0)
+			{
+				NotifyItem->SetText(FText::FromString(FString::Printf(TEXT("Rebuilding %d textures\n%d left in the texture compiler"),
+					NumOfChangedTextures, NumOfRemainingTextures)));
+				return true;
+			}
+
+			NotifyItem->SetText(FText::FromString(FString::Printf(TEXT("Rebuilt %d textures in %.1f s"),
+				NumOfChangedTextures, FPlatformTime::Seconds() - RebuildStartTime)));
+			NotifyItem->SetCompletionState(SNotificationItem::CS_Success);
+			NotifyItem->ExpireAndFadeout();
+
+			return false;
+		}), 0.25f);
+
+}//ShowCompileProgress.
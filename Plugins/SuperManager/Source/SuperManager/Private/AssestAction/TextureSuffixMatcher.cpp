@@ -0,0 +1,174 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssestAction/TextureSuffixMatcher.h"
+
+void FTextureSuffixMatcher::Reset()
+{
+	Patterns.Empty();
+	Transitions.Empty();
+	StateOutputs.Empty();
+
+}//Reset.
+
+void FTextureSuffixMatcher::AddSuffixes(const TArray<FString>& Suffixes, ETextureRole Role)
+{
+	for (const FString& Suffix : Suffixes)
+	{
+		if (Suffix.IsEmpty()) continue;
+
+		FSuffixPattern& Pattern = Patterns.AddDefaulted_GetRef();
+		Pattern.Suffix = Suffix;
+		Pattern.Role = Role;
+	}
+
+}//AddSuffixes.
+
+void FTextureSuffixMatcher::Compile()
+{
+	Transitions.Init(INDEX_NONE, AlphabetSize);
+	StateOutputs.Init(INDEX_NONE, 1);
+
+	//Build the trie.
+	for (int32 PatternIndex = 0; PatternIndex < Patterns.Num(); PatternIndex++)
+	{
+		int32 State = 0;
+
+		for (const TCHAR Character : Patterns[PatternIndex].Suffix)
+		{
+			int32& NextState = Transitions[State * AlphabetSize + ToSymbol(Character)];
+
+			if (NextState == INDEX_NONE)
+			{
+				NextState = StateOutputs.Num();
+				StateOutputs.Add(INDEX_NONE);
+				Transitions.AddUninitialized(AlphabetSize);
+				FMemory::Memset(&Transitions[Transitions.Num() - AlphabetSize], 0xFF, AlphabetSize * sizeof(int32));
+			}
+			State = Transitions[State * AlphabetSize + ToSymbol(Character)];
+		}
+
+		if (IsBetterPattern(PatternIndex, StateOutputs[State]))
+		{
+			StateOutputs[State] = PatternIndex;
+		}
+	}
+
+	//Breadth first pass turns the trie into a full automaton, so matching never follows failure links.
+	TArray<int32> FailureLinks;
+	FailureLinks.Init(0, StateOutputs.Num());
+
+	TArray<int32> StateQueue;
+	StateQueue.Reserve(StateOutputs.Num());
+
+	for (int32 Symbol = 0; Symbol < AlphabetSize; Symbol++)
+	{
+		int32& NextState = Transitions[Symbol];
+
+		if (NextState == INDEX_NONE)
+		{
+			NextState = 0;
+		}
+		else
+		{
+			FailureLinks[NextState] = 0;
+			StateQueue.Add(NextState);
+		}
+	}
+
+	for (int32 QueueIndex = 0; QueueIndex < StateQueue.Num(); QueueIndex++)
+	{
+		const int32 State = StateQueue[QueueIndex];
+		const int32 FailureState = FailureLinks[State];
+
+		if (IsBetterPattern(StateOutputs[FailureState], StateOutputs[State]))
+		{
+			StateOutputs[State] = StateOutputs[FailureState];
+		}
+
+		for (int32 Symbol = 0; Symbol < AlphabetSize; Symbol++)
+		{
+			int32& NextState = Transitions[State * AlphabetSize + Symbol];
+
+			if (NextState == INDEX_NONE)
+			{
+				NextState = Transitions[FailureState * AlphabetSize + Symbol];
+			}
+			else
+			{
+				FailureLinks[NextState] = Transitions[FailureState * AlphabetSize + Symbol];
+				StateQueue.Add(NextState);
+			}
+		}
+	}
+
+}//Compile.
+
+bool FTextureSuffixMatcher::Classify(FStringView TextureName, ETextureRole& OutRole, FString& OutBaseName) const
+{
+	int32 MatchStart = INDEX_NONE;
+	const int32 PatternIndex = FindBestMatch(TextureName, MatchStart);
+
+	if (PatternIndex == INDEX_NONE)
+	{
+		OutRole = ETextureRole::None;
+		return false;
+	}
+
+	OutRole = Patterns[PatternIndex].Role;
+	OutBaseName = FString(TextureName.Left(MatchStart));
+	return true;
+
+}//Classify.
+
+ETextureRole FTextureSuffixMatcher::ClassifyRole(FStringView TextureName) const
+{
+	int32 MatchStart = INDEX_NONE;
+	const int32 PatternIndex = FindBestMatch(TextureName, MatchStart);
+
+	return PatternIndex == INDEX_NONE ? ETextureRole::None : Patterns[PatternIndex].Role;
+
+}//ClassifyRole.
+
+int32 FTextureSuffixMatcher::ToSymbol(TCHAR Character)
+{
+	return Character < 128 ? FChar::ToLower(Character) : AlphabetSize - 1;
+
+}//ToSymbol.
+
+//Longer suffixes are more specific, on equal length the one added first wins.
+bool FTextureSuffixMatcher::IsBetterPattern(int32 PatternIndex, int32 OtherPatternIndex) const
+{
+	if (PatternIndex == INDEX_NONE) return false;
+	if (OtherPatternIndex == INDEX_NONE) return true;
+
+	const int32 Length = Patterns[PatternIndex].Suffix.Len();
+	const int32 OtherLength = Patterns[OtherPatternIndex].Suffix.Len();
+
+	return Length != OtherLength ? Length > OtherLength : PatternIndex < OtherPatternIndex;
+
+}//IsBetterPattern.
+
+int32 FTextureSuffixMatcher::FindBestMatch(FStringView TextureName, int32& OutMatchStart) const
+{
+	if (Transitions.Num() == 0) return INDEX_NONE;
+
+	int32 BestPatternIndex = INDEX_NONE;
+	int32 State = 0;
+
+	for (int32 CharIndex = 0; CharIndex < TextureName.Len(); CharIndex++)
+	{
+		State = Transitions[State * AlphabetSize + ToSymbol(TextureName[CharIndex])];
+
+		const int32 PatternIndex = StateOutputs[State];
+
+		if (IsBetterPattern(PatternIndex, BestPatternIndex))
+		{
+			BestPatternIndex = PatternIndex;
+			OutMatchStart = CharIndex + 1 - Patterns[PatternIndex].Suffix.Len();
+		}
+	}
+
+	return BestPatternIndex;
+
+}//FindBestMatch.
@@ -10,23 +10,32 @@
 #define  ListAll TEXT("List All Available Assets")
 #define  ListUnused TEXT("List Unused Assets")
 #define  ListSameName TEXT("List Assets With Same Name")
+#define  ListTextureMemory TEXT("List Textures Wasting Memory")
+#define  ListDependencyClosures TEXT("List Heaviest Hard Reference Chains")
+#define  ListReferenceCycles TEXT("List Hard Reference Cycles")
 
 
 void SAdvanceDeletionTab::Construct(const FArguments& Ina)
 {
 	bCanSupportFocus = true;
 
-	StoredAssetsData = Ina._AssetsDataToStore;
-	DisplayedAssetData = Ina._AssetsDataToStore;
+	AssetRows = Ina._AssetRows.IsValid() ? Ina._AssetRows : MakeShared<FAssetRowTable>();
+
+	TArray<int32> LiveRows;
+	AssetRows->GetLiveRows(LiveRows);
+	SetDisplayedRows(LiveRows);
 
 	CheckBoxesArray.Empty();
-	AssetsDataToDeleteArray.Empty();
+	SelectedRows.Empty();
 	ComboSourceItems.Empty();
 
 
 	ComboSourceItems.Add(MakeShared<FString>(ListAll));
 	ComboSourceItems.Add(MakeShared<FString>(ListUnused));
 	ComboSourceItems.Add(MakeShared<FString>(ListSameName));
+	ComboSourceItems.Add(MakeShared<FString>(ListTextureMemory));
+	ComboSourceItems.Add(MakeShared<FString>(ListDependencyClosures));
+	ComboSourceItems.Add(MakeShared<FString>(ListReferenceCycles));
 
 
 	FSlateFontInfo TitleTextFont = GetEmboseedTextFont();
@@ -60,6 +69,13 @@ void SAdvanceDeletionTab::Construct(const FArguments& Ina)
 						
 						]
 
+						//Sort button, only shown for listings with a metric
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						[
+							ConstructSortByMetricButton()
+						]
+
 						//Help Text For Combo Box
 						+ SHorizontalBox::Slot()
 						.FillWidth(.6f)
@@ -119,16 +135,24 @@ void SAdvanceDeletionTab::Construct(const FArguments& Ina)
 							ConstructDeselectAllButton()
 						]
 
+						//Button4 slot, only shown for the texture memory listing
+						+ SHorizontalBox::Slot()
+						.FillWidth(10.f)
+						.Padding(5.f)
+						[
+							ConstructFixTexturesButton()
+						]
+
 				]
 		];
 }//Construct.
 
 
-TSharedRef<SListView<TSharedPtr<FAssetData>>> SAdvanceDeletionTab::ConstructAssetListView()
+TSharedRef<SListView<FAssetRowTable::FRowItem>> SAdvanceDeletionTab::ConstructAssetListView()
 {
-	ConstructedAssetListView = SNew(SListView<TSharedPtr<FAssetData>>)
+	ConstructedAssetListView = SNew(SListView<FAssetRowTable::FRowItem>)
 		.ItemHeight(24.f)
-		.ListItemsSource(&DisplayedAssetData)
+		.ListItemsSource(&DisplayedItems)
 		.OnGenerateRow(this, &SAdvanceDeletionTab::OnGenerateRowForList)
 		.OnMouseButtonClick(this, &SAdvanceDeletionTab::OnRowWidgetMouseButtonClicked);
 		
@@ -138,7 +162,7 @@ TSharedRef<SListView<TSharedPtr<FAssetData>>> SAdvanceDeletionTab::ConstructAsse
 
 void SAdvanceDeletionTab::RefreshAssetListView()
 {
-	AssetsDataToDeleteArray.Empty();
+	SelectedRows.Empty();
 	CheckBoxesArray.Empty();
 
 	if (ConstructedAssetListView.IsValid())
@@ -147,6 +171,32 @@ void SAdvanceDeletionTab::RefreshAssetListView()
 	}
 }//RefreshAssetListView.
 
+void SAdvanceDeletionTab::SetDisplayedRows(const TArray<int32>& RowsToDisplay)
+{
+	DisplayedItems.Reset(RowsToDisplay.Num());
+
+	for (const int32 Row : RowsToDisplay)
+	{
+		DisplayedItems.Add(AssetRows->GetItem(Row));
+	}
+
+}//SetDisplayedRows.
+
+void SAdvanceDeletionTab::RemoveDeletedRows(const TArray<int32>& DeletedRows)
+{
+	for (const int32 DeletedRow : DeletedRows)
+	{
+		AssetRows->MarkDeleted(DeletedRow);
+		DisplayedMetrics.Remove(AssetRows->GetPackageName(DeletedRow));
+	}
+
+	DisplayedItems.RemoveAll([this](FAssetRowTable::FRowItem Item)
+		{
+			return AssetRows->HasFlags(AssetRows->GetRow(Item), EAssetRowFlags::Deleted);
+		});
+
+}//RemoveDeletedRows.
+
 #pragma region ComboBoxForListingCondition
 
 TSharedRef<SComboBox<TSharedPtr<FString>>> SAdvanceDeletionTab::ConstructComboBox()
@@ -179,22 +229,60 @@ void SAdvanceDeletionTab::OnComboSelectionChanged(TSharedPtr<FString> SelectedOp
 	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked< FSuperManagerModule>(TEXT("SuperManager"));
 	//Pass data for our moudle to filter based on selected option.
 
+	CurrentListingOption = *SelectedOption.Get();
+	DisplayedMetrics.Empty();
+
+	//Listings filter the rows still in the table and hand back the ones to show.
+	TArray<int32> LiveRows;
+	AssetRows->GetLiveRows(LiveRows);
+
+	TArray<int32> RowsToDisplay;
+
 	if (*SelectedOption.Get() == ListAll)
 	{
 		//List All Stored Data.
-		DisplayedAssetData = StoredAssetsData;
+		SetDisplayedRows(LiveRows);
 		RefreshAssetListView();
 	}
 	else if (*SelectedOption.Get() == ListUnused)
 	{
 		//List All Unused Assets.
-		SuperManagerModule.ListUnusedAssetsForAssetList(StoredAssetsData, DisplayedAssetData);
+		SuperManagerModule.ListUnusedAssetsForAssetList(*AssetRows, LiveRows, RowsToDisplay);
+		SetDisplayedRows(RowsToDisplay);
 		RefreshAssetListView();
 	}
 	else if (*SelectedOption.Get() == ListSameName)
 	{
 		//List All Unused Assets.
-		SuperManagerModule.ListSameNameAssetsForAssetList(StoredAssetsData, DisplayedAssetData);
+		SuperManagerModule.ListSameNameAssetsForAssetList(*AssetRows, LiveRows, RowsToDisplay);
+		SetDisplayedRows(RowsToDisplay);
+		RefreshAssetListView();
+	}
+	else if (*SelectedOption.Get() == ListTextureMemory)
+	{
+		//List textures that waste memory, biggest saving first.
+		SuperManagerModule.ListTextureMemoryForAssetList(*AssetRows, LiveRows, RowsToDisplay, DisplayedMetrics);
+		SetDisplayedRows(RowsToDisplay);
+		bSortMetricDescending = true;
+		SortDisplayedAssetsByMetric();
+		RefreshAssetListView();
+	}
+	else if (*SelectedOption.Get() == ListReferenceCycles)
+	{
+		//List assets caught in hard reference cycles, largest cycle first.
+		SuperManagerModule.ListReferenceCyclesForAssetList(*AssetRows, LiveRows, RowsToDisplay, DisplayedMetrics);
+		SetDisplayedRows(RowsToDisplay);
+		bSortMetricDescending = true;
+		SortDisplayedAssetsByMetric();
+		RefreshAssetListView();
+	}
+	else if (*SelectedOption.Get() == ListDependencyClosures)
+	{
+		//List assets by how much they load through hard references, worst first.
+		SuperManagerModule.ListDependencyClosuresForAssetList(*AssetRows, LiveRows, RowsToDisplay, DisplayedMetrics);
+		SetDisplayedRows(RowsToDisplay);
+		bSortMetricDescending = true;
+		SortDisplayedAssetsByMetric();
 		RefreshAssetListView();
 	}
 
@@ -215,14 +303,62 @@ TSharedRef<STextBlock> SAdvanceDeletionTab::ConstructComboHelpTexts(const FStrin
 #pragma endregion
 
 
+#pragma region MetricForAssetListView
+
+void SAdvanceDeletionTab::SortDisplayedAssetsByMetric()
+{
+	DisplayedItems.Sort([this](FAssetRowTable::FRowItem A, FAssetRowTable::FRowItem B)
+		{
+			const FAssetListMetric* MetricA = DisplayedMetrics.Find(*A);
+			const FAssetListMetric* MetricB = DisplayedMetrics.Find(*B);
+
+			const int64 ValueA = MetricA ? MetricA->Value : 0;
+			const int64 ValueB = MetricB ? MetricB->Value : 0;
+
+			return bSortMetricDescending ? ValueA > ValueB : ValueA < ValueB;
+		});
+
+}//SortDisplayedAssetsByMetric.
+
+TSharedRef<SButton> SAdvanceDeletionTab::ConstructSortByMetricButton()
+{
+	TSharedRef<SButton> SortButton = SNew(SButton)
+		.ContentPadding(FMargin(5.f))
+		.OnClicked(this, &SAdvanceDeletionTab::OnSortByMetricButtonClicked)
+		.Visibility_Lambda([this]() { return DisplayedMetrics.Num() > 0 ? EVisibility::Visible : EVisibility::Collapsed; });
+
+	SortButton->SetContent(
+		SNew(STextBlock)
+		.Text_Lambda([this]() { return FText::FromString(bSortMetricDescending ? TEXT("Largest First") : TEXT("Smallest First")); }));
+
+	return SortButton;
+
+}//ConstructSortByMetricButton.
+
+FReply SAdvanceDeletionTab::OnSortByMetricButtonClicked()
+{
+	bSortMetricDescending = !bSortMetricDescending;
+
+	SortDisplayedAssetsByMetric();
+	RefreshAssetListView();
+
+	return FReply::Handled();
+
+}//OnSortByMetricButtonClicked.
+
+#pragma endregion
+
+
 #pragma region RowWidgetForAssetListView
 
-TSharedRef<ITableRow> SAdvanceDeletionTab::OnGenerateRowForList(TSharedPtr<FAssetData> AssetDataToDisplay, const TSharedRef<STableViewBase>& OwnerTable)
+TSharedRef<ITableRow> SAdvanceDeletionTab::OnGenerateRowForList(FAssetRowTable::FRowItem ItemToDisplay, const TSharedRef<STableViewBase>& OwnerTable)
 {
-	if (!AssetDataToDisplay.IsValid())return SNew(STableRow < TSharedPtr <FAssetData> >, OwnerTable);
+	if (!ItemToDisplay)return SNew(STableRow < FAssetRowTable::FRowItem >, OwnerTable);
+
+	const int32 RowToDisplay = AssetRows->GetRow(ItemToDisplay);
 
-	const FString DisplayAssetClassName = AssetDataToDisplay->GetClass()->GetName();
-	const FString DisplayAssetName = AssetDataToDisplay->AssetName.ToString();
+	const FString DisplayAssetClassName = AssetRows->GetAssetClassPath(RowToDisplay).GetAssetName().ToString();
+	const FString DisplayAssetName = AssetRows->GetAssetName(RowToDisplay).ToString();
 
 	FSlateFontInfo AssetClassNameFont = GetEmboseedTextFont();
 	AssetClassNameFont.Size = 12;
@@ -230,8 +366,10 @@ TSharedRef<ITableRow> SAdvanceDeletionTab::OnGenerateRowForList(TSharedPtr<FAsse
 	FSlateFontInfo AssetNameFont = GetEmboseedTextFont();
 	AssetNameFont.Size = 15;
 
-	TSharedRef< STableRow < TSharedPtr <FAssetData> > > ListViewRowWidget =
-		SNew(STableRow < TSharedPtr <FAssetData> >, OwnerTable)
+	const FAssetListMetric* AssetMetric = DisplayedMetrics.Find(AssetRows->GetPackageName(RowToDisplay));
+
+	TSharedRef< STableRow < FAssetRowTable::FRowItem > > ListViewRowWidget =
+		SNew(STableRow < FAssetRowTable::FRowItem >, OwnerTable)
 		.Padding(FMargin(6.f))
 		[
 			SNew(SHorizontalBox)
@@ -242,7 +380,7 @@ TSharedRef<ITableRow> SAdvanceDeletionTab::OnGenerateRowForList(TSharedPtr<FAsse
 				.VAlign(VAlign_Center)
 				.FillWidth(0.05f)
 				[
-					ConstructCheckBox(AssetDataToDisplay)
+					ConstructCheckBox(RowToDisplay)
 				]
 
 			//Second slot for displaying asset class name
@@ -261,12 +399,20 @@ TSharedRef<ITableRow> SAdvanceDeletionTab::OnGenerateRowForList(TSharedPtr<FAsse
 				[
 					ConstructTextForRowWidget(DisplayAssetName, AssetNameFont)
 				]
+			//Metric slot, empty unless the listing measures something
+				+ SHorizontalBox::Slot()
+				.HAlign(HAlign_Left)
+				.VAlign(VAlign_Fill)
+				.FillWidth(AssetMetric ? 0.5f : 0.f)
+				[
+					ConstructTextForRowWidget(AssetMetric ? AssetMetric->Text : FString(), AssetClassNameFont)
+				]
 			//Fourth slot for a button
 				+SHorizontalBox::Slot()
 				.HAlign(HAlign_Center)
 				.VAlign(VAlign_Fill)
 				[
-					ConstructButtonForRowWidget(AssetDataToDisplay)
+					ConstructButtonForRowWidget(RowToDisplay)
 				
 				]
 		];
@@ -276,20 +422,20 @@ TSharedRef<ITableRow> SAdvanceDeletionTab::OnGenerateRowForList(TSharedPtr<FAsse
 }//OnGenerateRowForList.
 
 
-void SAdvanceDeletionTab::OnRowWidgetMouseButtonClicked(TSharedPtr<FAssetData> ClickedData)
+void SAdvanceDeletionTab::OnRowWidgetMouseButtonClicked(FAssetRowTable::FRowItem ClickedItem)
 {
 	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked< FSuperManagerModule>(TEXT("SuperManager"));
 
-	SuperManagerModule.SyncCBToClickedAssetForAssetList(ClickedData->ObjectPath.ToString());
+	SuperManagerModule.SyncCBToClickedAssetForAssetList(AssetRows->GetObjectPath(AssetRows->GetRow(ClickedItem)).ToString());
 
 }//OnRowWidgetMouseButtonClicked.
 
 
-TSharedRef<SCheckBox> SAdvanceDeletionTab::ConstructCheckBox(const TSharedPtr<FAssetData>& AssetDataToDisplay)
+TSharedRef<SCheckBox> SAdvanceDeletionTab::ConstructCheckBox(int32 RowToDisplay)
 {
 	TSharedRef<SCheckBox> ConstructedCheckBox = SNew(SCheckBox)
 		.Type(ESlateCheckBoxType::CheckBox)
-		.OnCheckStateChanged(this,& SAdvanceDeletionTab::OnCheckBoxStateChanged, AssetDataToDisplay)
+		.OnCheckStateChanged(this,& SAdvanceDeletionTab::OnCheckBoxStateChanged, RowToDisplay)
 		.Visibility(EVisibility::Visible);
 
 	CheckBoxesArray.Add(ConstructedCheckBox);
@@ -311,34 +457,34 @@ TSharedRef<STextBlock> SAdvanceDeletionTab::ConstructTextForRowWidget(const FStr
 }//ConstructTextForRowWidget.
 
 
-TSharedRef<SButton> SAdvanceDeletionTab::ConstructButtonForRowWidget(const TSharedPtr<FAssetData>& AssetDataToDisplay)
+TSharedRef<SButton> SAdvanceDeletionTab::ConstructButtonForRowWidget(int32 RowToDisplay)
 {
 	TSharedRef<SButton> ConstructedButton = SNew(SButton)
 		.Text(FText::FromString(TEXT("Delete")))
-		.OnClicked(this, &SAdvanceDeletionTab::OnDeleteButtonClicked, AssetDataToDisplay);
+		.OnClicked(this, &SAdvanceDeletionTab::OnDeleteButtonClicked, RowToDisplay);
 
 	return ConstructedButton;
 
 }//ConstructButtonForRowWidget.
 
 
-void SAdvanceDeletionTab::OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData)
+void SAdvanceDeletionTab::OnCheckBoxStateChanged(ECheckBoxState NewState, int32 Row)
 {
 	switch (NewState)
 	{
 	case ECheckBoxState::Unchecked:
 
-		//DebugHeader::Print(AssetData->AssetName.ToString()+TEXT(" is unchecked"), FColor::Red);
-		if (AssetsDataToDeleteArray.Contains(AssetData))
+		//DebugHeader::Print(AssetRows->GetAssetName(Row).ToString()+TEXT(" is unchecked"), FColor::Red);
+		if (SelectedRows.Contains(Row))
 		{
-			AssetsDataToDeleteArray.Remove(AssetData);
+			SelectedRows.Remove(Row);
 		}
 		break;
 
 	case ECheckBoxState::Checked:
 
-		//DebugHeader::Print(AssetData->AssetName.ToString() + TEXT(" is checked"), FColor::Green);
-		AssetsDataToDeleteArray.AddUnique(AssetData);
+		//DebugHeader::Print(AssetRows->GetAssetName(Row).ToString() + TEXT(" is checked"), FColor::Green);
+		SelectedRows.AddUnique(Row);
 		break;
 
 	case ECheckBoxState::Undetermined:
@@ -351,24 +497,17 @@ void SAdvanceDeletionTab::OnCheckBoxStateChanged(ECheckBoxState NewState, TShare
 }//OnCheckBoxStateChanged.
 
 
-FReply SAdvanceDeletionTab::OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAssetData)
+FReply SAdvanceDeletionTab::OnDeleteButtonClicked(int32 ClickedRow)
 {
 	FSuperManagerModule& SuperManagerModule =FModuleManager::LoadModuleChecked< FSuperManagerModule>(TEXT("SuperManager"));
 
-	const bool bAssetDeleted = SuperManagerModule.DeleteSingleAssetForAssetList(*ClickedAssetData.Get());
+	const bool bAssetDeleted = SuperManagerModule.DeleteSingleAssetForAssetList(AssetRows->GetAssetData(ClickedRow));
 
 	if (bAssetDeleted)
 	{
 		//Updating the list Source item
-		if (StoredAssetsData.Contains(ClickedAssetData))
-		{
-			StoredAssetsData.Remove(ClickedAssetData);
-		}
+		RemoveDeletedRows({ ClickedRow });
 
-		if (DisplayedAssetData.Contains(ClickedAssetData))
-		{
-			DisplayedAssetData.Remove(ClickedAssetData);
-		}
 		//Refresh the list
 		RefreshAssetListView();
 	}
@@ -419,21 +558,35 @@ TSharedRef<SButton> SAdvanceDeletionTab::ConstructDeselectAllButton()
 	return DeselectAllButton;
 }
 
+TSharedRef<SButton> SAdvanceDeletionTab::ConstructFixTexturesButton()
+{
+	TSharedRef<SButton> FixTexturesButton = SNew(SButton)
+		.ContentPadding(FMargin(5.f))
+		.OnClicked(this, &SAdvanceDeletionTab::OnFixTexturesButtonClicked)
+		.Visibility_Lambda([this]() { return CurrentListingOption == ListTextureMemory ? EVisibility::Visible : EVisibility::Collapsed; });
+
+
+	FixTexturesButton->SetContent(ConstructTextForTabButtons(TEXT("Fix Selected Textures")));
+
+	return FixTexturesButton;
+}
+
 FReply SAdvanceDeletionTab::OnDeleteAllButtonClicked()
 {
 	//DebugHeader::Print(TEXT("Delete All Button Clicked "), FColor::Red);
-	if (AssetsDataToDeleteArray.Num() == 0)
+	if (SelectedRows.Num() == 0)
 	{
 		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("No asset currently selected"));
 		return FReply::Handled() ;
 
 	}//if
 	
-	 //Pass data to our module for deletion.
+	 //Pass data to our module for deletion, full registry entries only for the selected rows.
 	TArray<FAssetData> AssetDataToDelete;
-	for (const TSharedPtr <FAssetData>& Data : AssetsDataToDeleteArray)
+	AssetDataToDelete.Reserve(SelectedRows.Num());
+	for (const int32 Row : SelectedRows)
 	{
-		AssetDataToDelete.Add(*Data.Get());
+		AssetDataToDelete.Add(AssetRows->GetAssetData(Row));
 	}
 
 	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked< FSuperManagerModule>(TEXT("SuperManager"));
@@ -442,19 +595,7 @@ FReply SAdvanceDeletionTab::OnDeleteAllButtonClicked()
 
 	if (bAssetsDeleted)
 	{
-		for (const TSharedPtr <FAssetData>& DeletedData : AssetsDataToDeleteArray)
-		{
-			if (StoredAssetsData.Contains(DeletedData))
-			{
-				StoredAssetsData.Remove(DeletedData);
-			}
-
-			if (DisplayedAssetData.Contains(DeletedData))
-			{
-				DisplayedAssetData.Remove(DeletedData);
-			}
-
-		}//loop
+		RemoveDeletedRows(SelectedRows);
 
 		RefreshAssetListView();
 	}//if
@@ -498,6 +639,44 @@ FReply SAdvanceDeletionTab::OnDeselectAllButtonClicked()
 	return FReply::Handled();
 }
 
+FReply SAdvanceDeletionTab::OnFixTexturesButtonClicked()
+{
+	if (SelectedRows.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No asset currently selected"));
+		return FReply::Handled();
+	}
+
+	TArray<FAssetData> TexturesToFix;
+	TexturesToFix.Reserve(SelectedRows.Num());
+	for (const int32 Row : SelectedRows)
+	{
+		TexturesToFix.Add(AssetRows->GetAssetData(Row));
+	}
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked< FSuperManagerModule>(TEXT("SuperManager"));
+
+	const TArray<FName> FixedPackageNames = SuperManagerModule.FixTexturesForAssetList(TexturesToFix);
+
+	if (FixedPackageNames.Num() > 0)
+	{
+		//Only textures that were changed drop out of the listing, their registry tags only update once they are saved.
+		for (const FName& FixedPackageName : FixedPackageNames)
+		{
+			const int32 FixedRow = AssetRows->FindRow(FixedPackageName);
+			if (FixedRow == INDEX_NONE) continue;
+
+			DisplayedItems.Remove(AssetRows->GetItem(FixedRow));
+			DisplayedMetrics.Remove(FixedPackageName);
+			SelectedRows.Remove(FixedRow);
+		}
+
+		RefreshAssetListView();
+	}
+
+	return FReply::Handled();
+}//OnFixTexturesButtonClicked.
+
 TSharedRef<STextBlock> SAdvanceDeletionTab::ConstructTextForTabButtons(const FString& TextContent)
 {
 	FSlateFontInfo ButtonTextFont = GetEmboseedTextFont();
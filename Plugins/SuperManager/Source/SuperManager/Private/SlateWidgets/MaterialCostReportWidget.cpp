@@ -0,0 +1,213 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SlateWidgets/MaterialCostReportWidget.h"
+#include "SlateBasics.h"
+#include "SuperManager.h"
+
+
+namespace MaterialCostReportColumns
+{
+	static const FName Name(TEXT("Name"));
+	static const FName Permutations(TEXT("Permutations"));
+	static const FName StaticSwitches(TEXT("StaticSwitches"));
+	static const FName UsageFlags(TEXT("UsageFlags"));
+	static const FName Samplers(TEXT("Samplers"));
+	static const FName PixelInstructions(TEXT("PixelInstructions"));
+	static const FName VertexInstructions(TEXT("VertexInstructions"));
+
+	static int64 GetMetric(const FMaterialCostEntry& Entry, const FName& ColumnId)
+	{
+		if (ColumnId == Permutations) return Entry.NumPermutations;
+		if (ColumnId == StaticSwitches) return Entry.NumStaticSwitches + Entry.NumStaticComponentMasks;
+		if (ColumnId == UsageFlags) return Entry.NumUsageFlags;
+		if (ColumnId == Samplers) return Entry.NumSamplers;
+		if (ColumnId == PixelInstructions) return Entry.NumPixelInstructions;
+		if (ColumnId == VertexInstructions) return Entry.NumVertexInstructions;
+		return 0;
+	}
+}
+
+class SMaterialCostReportRow : public SMultiColumnTableRow<TSharedPtr<FMaterialCostEntry>>
+{
+public:
+
+	SLATE_BEGIN_ARGS(SMaterialCostReportRow){}
+
+	SLATE_ARGUMENT(TSharedPtr<FMaterialCostEntry>, EntryToDisplay)
+
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+	{
+		DisplayedEntry = InArgs._EntryToDisplay;
+
+		SMultiColumnTableRow<TSharedPtr<FMaterialCostEntry>>::Construct(
+			FSuperRowType::FArguments().Padding(FMargin(4.f)), OwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		const FString CellText = ColumnName == MaterialCostReportColumns::Name ?
+			DisplayedEntry->AssetData.AssetName.ToString() :
+			LexToString(MaterialCostReportColumns::GetMetric(*DisplayedEntry, ColumnName));
+
+		return SNew(STextBlock)
+			.Text(FText::FromString(CellText))
+			.ColorAndOpacity(FColor::White);
+	}
+
+private:
+
+	TSharedPtr<FMaterialCostEntry> DisplayedEntry;
+};
+
+
+void SMaterialCostReportTab::Construct(const FArguments& InArgs)
+{
+	bCanSupportFocus = true;
+
+	StoredEntries = InArgs._EntriesToStore;
+
+	//Permutation explosions first.
+	SortColumnId = MaterialCostReportColumns::Permutations;
+	SortMode = EColumnSortMode::Descending;
+	SortEntries();
+
+	FSlateFontInfo TitleTextFont = GetEmboseedTextFont();
+	TitleTextFont.Size = 30;
+
+	ChildSlot
+		[
+			//Main Vertical Box.
+			SNew(SVerticalBox)
+				//First vertical slot for title text
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+						.Text(FText::FromString(TEXT("Material Cost Report")))
+						.Font(TitleTextFont)
+						.Justification(ETextJustify::Center)
+						.ColorAndOpacity(FColor::White)
+				]
+
+				//Second slot for help text and folder path
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+						.Text(FText::FromString(FString::Printf(
+							TEXT("%d materials under %s. Click a column header to sort, click a row to find the material."),
+							StoredEntries.Num(), *InArgs._CurrentSelectedFolder)))
+						.AutoWrapText(true)
+				]
+
+				//Third slot for the report
+				+ SVerticalBox::Slot()
+				.VAlign(VAlign_Fill)
+				[
+					ConstructEntryListView()
+				]
+		];
+
+}//Construct.
+
+
+TSharedRef<SListView<TSharedPtr<FMaterialCostEntry>>> SMaterialCostReportTab::ConstructEntryListView()
+{
+	//Every column sorts, the label and width are chained on at the call site.
+	auto SortableColumn = [this](const FName& ColumnId)
+	{
+		SHeaderRow::FColumn::FArguments ColumnArgs = SHeaderRow::Column(ColumnId);
+		ColumnArgs
+			.SortMode(this, &SMaterialCostReportTab::GetColumnSortMode, ColumnId)
+			.OnSort(this, &SMaterialCostReportTab::OnColumnSortModeChanged);
+
+		return ColumnArgs;
+	};
+
+	ConstructedEntryListView = SNew(SListView<TSharedPtr<FMaterialCostEntry>>)
+		.ItemHeight(24.f)
+		.ListItemsSource(&StoredEntries)
+		.OnGenerateRow(this, &SMaterialCostReportTab::OnGenerateRowForEntry)
+		.OnMouseButtonClick(this, &SMaterialCostReportTab::OnEntryMouseButtonClicked)
+		.HeaderRow
+		(
+			SNew(SHeaderRow)
+			+ SortableColumn(MaterialCostReportColumns::Name).DefaultLabel(FText::FromString(TEXT("Material"))).FillWidth(3.f)
+			+ SortableColumn(MaterialCostReportColumns::Permutations).DefaultLabel(FText::FromString(TEXT("Permutations"))).FillWidth(1.f)
+			+ SortableColumn(MaterialCostReportColumns::StaticSwitches).DefaultLabel(FText::FromString(TEXT("Static Switches"))).FillWidth(1.f)
+			+ SortableColumn(MaterialCostReportColumns::UsageFlags).DefaultLabel(FText::FromString(TEXT("Usage Flags"))).FillWidth(1.f)
+			+ SortableColumn(MaterialCostReportColumns::Samplers).DefaultLabel(FText::FromString(TEXT("Samplers"))).FillWidth(1.f)
+			+ SortableColumn(MaterialCostReportColumns::PixelInstructions).DefaultLabel(FText::FromString(TEXT("Pixel Instructions"))).FillWidth(1.f)
+			+ SortableColumn(MaterialCostReportColumns::VertexInstructions).DefaultLabel(FText::FromString(TEXT("Vertex Instructions"))).FillWidth(1.f)
+		);
+
+	return ConstructedEntryListView.ToSharedRef();
+
+}//ConstructEntryListView.
+
+
+TSharedRef<ITableRow> SMaterialCostReportTab::OnGenerateRowForEntry(TSharedPtr<FMaterialCostEntry> EntryToDisplay,
+	const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SMaterialCostReportRow, OwnerTable)
+		.EntryToDisplay(EntryToDisplay);
+
+}//OnGenerateRowForEntry.
+
+
+void SMaterialCostReportTab::OnEntryMouseButtonClicked(TSharedPtr<FMaterialCostEntry> ClickedEntry)
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked< FSuperManagerModule>(TEXT("SuperManager"));
+
+	SuperManagerModule.SyncCBToClickedAssetForAssetList(ClickedEntry->AssetData.GetObjectPathString());
+
+}//OnEntryMouseButtonClicked.
+
+
+#pragma region Sorting
+
+EColumnSortMode::Type SMaterialCostReportTab::GetColumnSortMode(FName ColumnId) const
+{
+	return ColumnId == SortColumnId ? SortMode : EColumnSortMode::None;
+
+}//GetColumnSortMode.
+
+void SMaterialCostReportTab::OnColumnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type NewSortMode)
+{
+	SortColumnId = ColumnId;
+	SortMode = NewSortMode;
+
+	SortEntries();
+
+	if (ConstructedEntryListView.IsValid())
+	{
+		ConstructedEntryListView->RequestListRefresh();
+	}
+
+}//OnColumnSortModeChanged.
+
+void SMaterialCostReportTab::SortEntries()
+{
+	const bool bAscending = SortMode == EColumnSortMode::Ascending;
+	const FName ColumnId = SortColumnId;
+
+	StoredEntries.Sort([bAscending, ColumnId](const TSharedPtr<FMaterialCostEntry>& A, const TSharedPtr<FMaterialCostEntry>& B)
+	{
+		if (ColumnId == MaterialCostReportColumns::Name)
+		{
+			return bAscending ? A->AssetData.AssetName.LexicalLess(B->AssetData.AssetName) :
+				B->AssetData.AssetName.LexicalLess(A->AssetData.AssetName);
+		}
+
+		const int64 MetricA = MaterialCostReportColumns::GetMetric(*A, ColumnId);
+		const int64 MetricB = MaterialCostReportColumns::GetMetric(*B, ColumnId);
+
+		return bAscending ? MetricA < MetricB : MetricA > MetricB;
+	});
+
+}//SortEntries.
+
+#pragma endregion
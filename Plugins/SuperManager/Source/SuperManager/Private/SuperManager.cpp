@@ -9,7 +9,25 @@
 #include "AssetToolsModule.h"
 #include "AssetViewUtils.h"
 #include "SlateWidgets/AdvanceDeletionWidget.h"
+#include "SlateWidgets/MaterialCostReportWidget.h"
+#include "Materials/Material.h"
+#include "MaterialEditingLibrary.h"
+#include "Misc/ScopedSlowTask.h"
+#include "AssestAction/AssetPrefixRules.h"
+#include "AssestAction/TextureMemoryAudit.h"
+#include "AssestAction/PackageDependencyGraph.h"
+#include "AssestAction/BackgroundAssetAuditor.h"
+#include "AssestAction/AssetRowTable.h"
+#include "AssestAction/SafeAssetDeleter.h"
+#include "AssestAction/PathLiteralScanner.h"
+#include "AssestAction/SourceChangeDetector.h"
+#include "Engine/Texture.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "CustomSettings/SuperManagerSettings.h"
 #include "CustomStyle/SuperManagerStyle.h"
+#include "Styling/AppStyle.h"
 #include "LevelEditor.h"
 #include "Engine/Selection.h"
 #include "Subsystems/EditorActorSubsystem.h"
@@ -25,6 +43,7 @@ void FSuperManagerModule::StartupModule()
 	FSuperManagerStyle::InitializeIcons();
 	InitCBMenuExtention();
 	RegisterAdvanceDeletionTab();
+	RegisterMaterialCostReportTab();
 
 	FSuperManagerUICommands::Register();
 	InitCustomUICommands();
@@ -35,6 +54,8 @@ void FSuperManagerModule::StartupModule()
 
 	InitSceneOutlinerColumnExtension();
 
+	BackgroundAuditor = MakeUnique<FBackgroundAssetAuditor>();
+
 }//StartupModule.
 
 void FSuperManagerModule::ShutdownModule()
@@ -42,11 +63,14 @@ void FSuperManagerModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FName("AdvanceDeletion"));
+	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FName("MaterialCostReport"));
 
 	FSuperManagerStyle::ShutDown();
 	FSuperManagerUICommands::Unregister();
 
 	UnRegisterSceneOutlinerColumnExtension();
+
+	BackgroundAuditor.Reset();
 }
 
 
@@ -124,6 +148,27 @@ void FSuperManagerModule::AddCBMenuEntry(FMenuBuilder& MenuBuilder)
 		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnAdvanceDeletionButtonClicked)//third binding, the actual function to execute.
 	);
 
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Material Cost Report")),//title for menu entry.
+		FText::FromString(TEXT("List shader permutations and instruction counts of all materials under folder.")),//tool tips for menu entry.
+		FSlateIcon(FAppStyle::GetAppStyleSetName(), "ClassIcon.Material"),//custom icons for menu entry.
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnMaterialCostReportButtonClicked)//third binding, the actual function to execute.
+	);
+
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Audit Naming Convention")),//title for menu entry.
+		FText::FromString(TEXT("Find all assets under folder missing their prefix and optionally rename them.")),//tool tips for menu entry.
+		FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Edit"),//custom icons for menu entry.
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnAuditNamingConventionButtonClicked)//third binding, the actual function to execute.
+	);
+
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Reimport Changed Sources")),//title for menu entry.
+		FText::FromString(TEXT("Reimport only the assets under folder whose source files changed since they were imported.")),//tool tips for menu entry.
+		FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Refresh"),//custom icons for menu entry.
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnReimportChangedSourcesButtonClicked)//third binding, the actual function to execute.
+	);
+
 }//AddCBMenuEntry.
 
 
@@ -160,32 +205,55 @@ void FSuperManagerModule::OnDeleteUnusedAssetButtonClicked()
 
 	TArray<FAssetData> UnusedAssetsDataArray;
 
-	for (const FString& AssetPathName : AssetsPathNames)
+	//The background audit already has the answer unless something changed since its last pass.
+	const bool bUseBackgroundAudit = BackgroundAuditor.IsValid() && BackgroundAuditor->CanAnswerFor(FolderPathsSelected[0]);
+
+	if (bUseBackgroundAudit)
 	{
-		//Don't touch root folder
-		if (AssetPathName.Contains(TEXT("Developers")) ||
-			AssetPathName.Contains(TEXT("Collections")) ||
-			AssetPathName.Contains(TEXT("__ExternalActors__")) ||
-			AssetPathName.Contains(TEXT("__ExternalObjects__")))
+		UnusedAssetsDataArray = BackgroundAuditor->GetUnusedAssetsUnder(FolderPathsSelected[0]);
+	}
+	else
+	{
+		for (const FString& AssetPathName : AssetsPathNames)
 		{
-			continue;
-		}
+			//Don't touch root folder
+			if (AssetPathName.Contains(TEXT("Developers")) ||
+				AssetPathName.Contains(TEXT("Collections")) ||
+				AssetPathName.Contains(TEXT("__ExternalActors__")) ||
+				AssetPathName.Contains(TEXT("__ExternalObjects__")))
+			{
+				continue;
+			}
 
-		if (!UEditorAssetLibrary::DoesAssetExist(AssetPathName)) continue;
+			if (!UEditorAssetLibrary::DoesAssetExist(AssetPathName)) continue;
 
-		TArray<FString> AssetReferencers =
-			UEditorAssetLibrary::FindPackageReferencersForAsset(AssetPathName);
+			TArray<FString> AssetReferencers =
+				UEditorAssetLibrary::FindPackageReferencersForAsset(AssetPathName);
 
-		if (AssetReferencers.Num() == 0)//if no reference then add it to unused array.
-		{
-			const FAssetData UnusedAssetData = UEditorAssetLibrary::FindAssetData(AssetPathName);
-			UnusedAssetsDataArray.Add(UnusedAssetData);
+			if (AssetReferencers.Num() == 0)//if no reference then add it to unused array.
+			{
+				const FAssetData UnusedAssetData = UEditorAssetLibrary::FindAssetData(AssetPathName);
+				UnusedAssetsDataArray.Add(UnusedAssetData);
+			}
 		}
 	}
 
+	//The registry does not know about paths written in config, code and data files.
+	const FPathLiteralScanner PathLiteralScanner = ScanPathLiterals();
+
+	UnusedAssetsDataArray.RemoveAll([&PathLiteralScanner](const FAssetData& AssetData)
+		{
+			const TArray<int32>* ReferencingFiles = PathLiteralScanner.FindReferencingFiles(AssetData.PackageName);
+			if (!ReferencingFiles) return false;
+
+			DebugHeader::PrintLog(AssetData.PackageName.ToString() + TEXT(" is kept, its path is written in ") +
+				PathLiteralScanner.GetScannedFiles()[(*ReferencingFiles)[0]]);
+			return true;
+		});
+
 	if (UnusedAssetsDataArray.Num() > 0)//if there is unused assets then delete it otherwise show msg.
 	{
-		ObjectTools::DeleteAssets(UnusedAssetsDataArray);
+		FSafeAssetDeleter::DeleteAssets(UnusedAssetsDataArray);
 	}
 	else
 	{
@@ -210,7 +278,12 @@ void FSuperManagerModule::OnDeleteEmptyFolderButtonClicked()
 	}
 	FixUpRedirectors();
 
-	TArray<FString> FolderPathsArray = UEditorAssetLibrary::ListAssets(FolderPathsSelected[0],true,true);
+	//The background audit already has the answer unless something changed since its last pass.
+	const bool bUseBackgroundAudit = BackgroundAuditor.IsValid() && BackgroundAuditor->CanAnswerFor(FolderPathsSelected[0]);
+
+	TArray<FString> FolderPathsArray = bUseBackgroundAudit ?
+		BackgroundAuditor->GetEmptyFoldersUnder(FolderPathsSelected[0]) :
+		UEditorAssetLibrary::ListAssets(FolderPathsSelected[0],true,true);
 	uint32 Counter = 0;
 
 	FString EmptyFolderPathsNames;
@@ -282,6 +355,248 @@ void FSuperManagerModule::OnAdvanceDeletionButtonClicked()
 
 }//OnAdvanceDeletionButtonClicked.
 
+void FSuperManagerModule::OnMaterialCostReportButtonClicked()
+{
+	if (FolderPathsSelected.Num() > 1)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("You can only do this to one folder"));
+		return;
+	}
+
+	MaterialCostReportFolder = FolderPathsSelected[0];
+
+	//Loading and collecting garbage happen here, behind the progress dialog, never while the tab manager spawns the tab.
+	MaterialCostEntries = GatherMaterialCostEntries(MaterialCostReportFolder);
+
+	if (MaterialCostEntries.Num() == 0) return;
+
+	//Close an open report first so the tab is rebuilt for the new folder.
+	if (TSharedPtr<SDockTab> ExistingTab = FGlobalTabmanager::Get()->FindExistingLiveTab(FName("MaterialCostReport")))
+	{
+		ExistingTab->RequestCloseTab();
+	}
+
+	FGlobalTabmanager::Get()->TryInvokeTab(FName("MaterialCostReport"));
+
+}//OnMaterialCostReportButtonClicked.
+
+//Registry data only, nothing is loaded until the user agrees to rename.
+void FSuperManagerModule::OnAuditNamingConventionButtonClicked()
+{
+	if (FolderPathsSelected.Num() > 1)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("You can only do this to one folder"));
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Asset Registry is still scanning, please try again once it is done"));
+		return;
+	}
+
+	const double AuditStartTime = FPlatformTime::Seconds();
+
+	TArray<FAssetData> AssetsData;
+	TArray<const FString*> Prefixes;
+	TArray<int32> ViolationIndices;
+	FString ReportSummary;
+
+	//Outlives the prefix pointers taken from it below.
+	TArray<FBackgroundAssetAuditor::FNamingViolation> CachedViolations;
+
+	FAssetPrefixRules PrefixRules;
+
+	if (BackgroundAuditor.IsValid() && BackgroundAuditor->CanAnswerFor(FolderPathsSelected[0]))
+	{
+		CachedViolations = BackgroundAuditor->GetNamingViolationsUnder(FolderPathsSelected[0]);
+
+		for (const FBackgroundAssetAuditor::FNamingViolation& Violation : CachedViolations)
+		{
+			ViolationIndices.Add(AssetsData.Add(Violation.AssetData));
+			Prefixes.Add(&Violation.Prefix);
+		}
+
+		ReportSummary = FString::Printf(TEXT("%d assets miss their prefix (from the background audit).\n\nBy folder:\n"),
+			ViolationIndices.Num());
+	}
+	else
+	{
+		FARFilter Filter;
+		Filter.bRecursivePaths = true;
+		Filter.PackagePaths.Emplace(*FolderPathsSelected[0]);
+
+		AssetRegistry.GetAssets(Filter, AssetsData);
+
+		//Don't touch root folder
+		AssetsData.RemoveAll([](const FAssetData& AssetData)
+			{
+				const FString PackagePath = AssetData.PackagePath.ToString();
+
+				return PackagePath.Contains(TEXT("Developers")) ||
+					PackagePath.Contains(TEXT("Collections")) ||
+					PackagePath.Contains(TEXT("__ExternalActors__")) ||
+					PackagePath.Contains(TEXT("__ExternalObjects__"));
+			});
+
+		ViolationIndices = PrefixRules.FindNamingViolations(AssetsData, Prefixes);
+
+		if (ViolationIndices.Num() == 0)
+		{
+			DebugHeader::ShowNotifyInfo(FString::Printf(TEXT("All %d assets follow the naming convention"), AssetsData.Num()));
+			return;
+		}
+
+		ReportSummary = FString::Printf(TEXT("%d of %d assets miss their prefix (checked in %.2f s).\n\nBy folder:\n"),
+			ViolationIndices.Num(), AssetsData.Num(), FPlatformTime::Seconds() - AuditStartTime);
+	}
+
+	if (ViolationIndices.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("All assets follow the naming convention"));
+		return;
+	}
+
+	TMap<FName, int32> ViolationsByFolder;
+	TMap<FName, int32> ViolationsByClass;
+
+	for (const int32 ViolationIndex : ViolationIndices)
+	{
+		const FAssetData& AssetData = AssetsData[ViolationIndex];
+
+		++ViolationsByFolder.FindOrAdd(AssetData.PackagePath);
+		++ViolationsByClass.FindOrAdd(AssetData.AssetClassPath.GetAssetName());
+
+		DebugHeader::PrintLog(AssetData.GetObjectPathString() + TEXT(" should start with ") + *Prefixes[ViolationIndex]);
+	}
+
+	ViolationsByFolder.ValueSort(TGreater<int32>());
+	ViolationsByClass.ValueSort(TGreater<int32>());
+
+	//Only the worst groups fit in a dialog, the full list is in the output log.
+	auto AppendTopGroups = [](FString& Report, const TMap<FName, int32>& ViolationsByGroup)
+		{
+			int32 NumOfGroupsListed = 0;
+
+			for (const TPair<FName, int32>& Group : ViolationsByGroup)
+			{
+				if (NumOfGroupsListed++ == 10)
+				{
+					Report += FString::Printf(TEXT("  ... and %d more\n"), ViolationsByGroup.Num() - 10);
+					break;
+				}
+
+				Report += FString::Printf(TEXT("  %s: %d\n"), *Group.Key.ToString(), Group.Value);
+			}
+		};
+
+	FString Report = ReportSummary;
+	AppendTopGroups(Report, ViolationsByFolder);
+
+	Report += TEXT("\nBy class:\n");
+	AppendTopGroups(Report, ViolationsByClass);
+
+	Report += TEXT("\nWould you like to add the missing prefixes now?");
+
+	const EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo, Report, false);
+
+	if (ConfirmResult != EAppReturnType::Yes) return;
+
+	TArray<FAssetData> AssetsToRename;
+	TArray<FString> NewNames;
+	AssetsToRename.Reserve(ViolationIndices.Num());
+	NewNames.Reserve(ViolationIndices.Num());
+
+	for (const int32 ViolationIndex : ViolationIndices)
+	{
+		AssetsToRename.Add(AssetsData[ViolationIndex]);
+		NewNames.Add(FAssetPrefixRules::ApplyPrefix(AssetsData[ViolationIndex], *Prefixes[ViolationIndex]));
+	}
+
+	const int32 NumOfRenamedAssets = FAssetPrefixRules::RenameAssets(AssetsToRename, NewNames);
+
+	if (NumOfRenamedAssets > 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully renamed ") + FString::FromInt(NumOfRenamedAssets) + TEXT(" assets"));
+	}
+
+}//OnAuditNamingConventionButtonClicked.
+
+void FSuperManagerModule::OnReimportChangedSourcesButtonClicked()
+{
+	if (FolderPathsSelected.Num() > 1)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("You can only do this to one folder"));
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Asset Registry is still scanning, please try again once it is done"));
+		return;
+	}
+
+	const double CheckStartTime = FPlatformTime::Seconds();
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.PackagePaths.Emplace(*FolderPathsSelected[0]);
+
+	TArray<FAssetData> AssetsData;
+	AssetRegistry.GetAssets(Filter, AssetsData);
+
+	//Import data is in the registry tags, nothing is loaded to compare.
+	const FSourceChangeReport Report = FSourceChangeDetector::FindChangedSources(AssetsData);
+
+	for (const FString& MissingSourceFile : Report.MissingSourceFiles)
+	{
+		DebugHeader::PrintLog(TEXT("Source file not found: ") + MissingSourceFile);
+	}
+
+	for (const FAssetData& ChangedAsset : Report.ChangedAssets)
+	{
+		DebugHeader::PrintLog(TEXT("Source changed: ") + ChangedAsset.GetObjectPathString());
+	}
+
+	FString Summary = FString::Printf(TEXT("%d of %d imported assets have a changed source file (%d files hashed in %.2f s)."),
+		Report.ChangedAssets.Num(), Report.NumOfCheckedAssets, Report.NumOfHashedFiles, FPlatformTime::Seconds() - CheckStartTime);
+
+	if (Report.MissingSourceFiles.Num() > 0)
+	{
+		Summary += FString::Printf(TEXT("\n%d source files are missing, see the output log."), Report.MissingSourceFiles.Num());
+	}
+
+	if (Report.NumOfUnhashedAssets > 0)
+	{
+		Summary += FString::Printf(TEXT("\n%d assets were imported without a file hash and are skipped."), Report.NumOfUnhashedAssets);
+	}
+
+	if (Report.ChangedAssets.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, Summary, false);
+		return;
+	}
+
+	const EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
+		Summary + TEXT("\n\nWould you like to reimport the changed assets now?"), false);
+
+	if (ConfirmResult != EAppReturnType::Yes) return;
+
+	const int32 NumOfReimportedAssets = FSourceChangeDetector::ReimportInBatches(Report.ChangedAssets, 16);
+
+	if (NumOfReimportedAssets > 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully reimported ") + FString::FromInt(NumOfReimportedAssets) + TEXT(" assets"));
+	}
+
+}//OnReimportChangedSourcesButtonClicked.
+
 void FSuperManagerModule::FixUpRedirectors()
 {
 	
@@ -359,7 +674,7 @@ TSharedRef<SDockTab> FSuperManagerModule::OnSpawnAdvanceDeletionTab(const FSpawn
 		SNew(SDockTab).TabRole(ETabRole::NomadTab)
 		[
 			SNew(SAdvanceDeletionTab)
-				.AssetsDataToStore(GetAllAssetDataUnderSelectedFolder())
+				.AssetRows(GetAssetRowsUnderSelectedFolder())
 				.CurrentSelectedFolder(FolderPathsSelected[0])
 
 		];
@@ -372,34 +687,38 @@ TSharedRef<SDockTab> FSuperManagerModule::OnSpawnAdvanceDeletionTab(const FSpawn
 }//RegisterAdvanceDeletionTab.
 
 
-TArray<TSharedPtr<FAssetData>> FSuperManagerModule::GetAllAssetDataUnderSelectedFolder()
+TSharedRef<FAssetRowTable> FSuperManagerModule::GetAssetRowsUnderSelectedFolder()
 {
-	TArray<TSharedPtr<FAssetData>> AvaiableAssetsData;
+	TSharedRef<FAssetRowTable> AssetRows = MakeShared<FAssetRowTable>();
 
-	TArray<FString> AssetsPathNames = UEditorAssetLibrary::ListAssets(FolderPathsSelected[0]);
-
-	for (const FString& AssetPathName : AssetsPathNames)
-	{
-		//Don't touch root folder
-		if (AssetPathName.Contains(TEXT("Developers")) ||
-			AssetPathName.Contains(TEXT("Collections")) ||
-			AssetPathName.Contains(TEXT("__ExternalActors__")) ||
-			AssetPathName.Contains(TEXT("__ExternalObjects__")))
-		{
-			continue;
-		}
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
 
-		if (!UEditorAssetLibrary::DoesAssetExist(AssetPathName)) continue;
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.PackagePaths.Emplace(*FolderPathsSelected[0]);
 
-		const FAssetData Data = UEditorAssetLibrary::FindAssetData(AssetPathName);
+	//Straight from the registry, each entry is read once and only its names are kept.
+	AssetRegistry.EnumerateAssets(Filter, [&AssetRows](const FAssetData& AssetData)
+		{
+			const FString PackagePath = AssetData.PackagePath.ToString();
 
-		AvaiableAssetsData.Add(MakeShared<FAssetData>(Data));
+			//Don't touch root folder
+			if (PackagePath.Contains(TEXT("Developers")) ||
+				PackagePath.Contains(TEXT("Collections")) ||
+				PackagePath.Contains(TEXT("__ExternalActors__")) ||
+				PackagePath.Contains(TEXT("__ExternalObjects__")))
+			{
+				return true;
+			}
 
-	}//Loop.
+			AssetRows->AddRow(AssetData);
+			return true;
+		});
 
-	return AvaiableAssetsData;
+	return AssetRows;
 
-}//GetAllAssetDataUnderSelectedFolder.
+}//GetAssetRowsUnderSelectedFolder.
 
 void FSuperManagerModule::OnAdvanceDeletionTabClosed(TSharedRef<SDockTab> TabToClose)
 {
@@ -411,6 +730,118 @@ void FSuperManagerModule::OnAdvanceDeletionTabClosed(TSharedRef<SDockTab> TabToC
 }//OnAdvanceDeletionTabClosed.
 
 
+#pragma endregion
+
+
+#pragma region MaterialCostReport
+
+void FSuperManagerModule::RegisterMaterialCostReportTab()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(FName("MaterialCostReport"),
+		FOnSpawnTab::CreateRaw(this, &FSuperManagerModule::OnSpawnMaterialCostReportTab))
+		.SetDisplayName(FText::FromString(TEXT("Material Cost Report")))
+		.SetIcon(FSlateIcon(FAppStyle::GetAppStyleSetName(), "ClassIcon.Material"));
+
+}//RegisterMaterialCostReportTab.
+
+TSharedRef<SDockTab> FSuperManagerModule::OnSpawnMaterialCostReportTab(const FSpawnTabArgs& SpawnTab)
+{
+	if (MaterialCostReportFolder.IsEmpty()) return SNew(SDockTab).TabRole(ETabRole::NomadTab);
+
+	//Entries were gathered by the menu action, spawning only builds the widgets.
+	return SNew(SDockTab).TabRole(ETabRole::NomadTab)
+		[
+			SNew(SMaterialCostReportTab)
+				.EntriesToStore(MaterialCostEntries)
+				.CurrentSelectedFolder(MaterialCostReportFolder)
+		];
+
+}//OnSpawnMaterialCostReportTab.
+
+//Materials are loaded a chunk at a time and collected again, so the report never holds more than one chunk in memory.
+TArray<TSharedPtr<FMaterialCostEntry>> FSuperManagerModule::GatherMaterialCostEntries(const FString& FolderPath)
+{
+	TArray<TSharedPtr<FMaterialCostEntry>> CostEntries;
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.PackagePaths.Emplace(*FolderPath);
+	Filter.ClassPaths.Add(UMaterial::StaticClass()->GetClassPathName());
+
+	TArray<FAssetData> MaterialsData;
+	AssetRegistry.GetAssets(Filter, MaterialsData);
+
+	if (MaterialsData.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No material found under ") + FolderPath);
+		return CostEntries;
+	}
+
+	constexpr int32 MaterialsPerChunk = 32;
+
+	FScopedSlowTask GatherTask((float)MaterialsData.Num(), FText::FromString(TEXT("Gathering material costs")));
+	GatherTask.MakeDialog(true);
+
+	for (int32 ChunkStart = 0; ChunkStart < MaterialsData.Num(); ChunkStart += MaterialsPerChunk)
+	{
+		const int32 ChunkEnd = FMath::Min(ChunkStart + MaterialsPerChunk, MaterialsData.Num());
+
+		for (int32 MaterialIndex = ChunkStart; MaterialIndex < ChunkEnd; MaterialIndex++)
+		{
+			const FAssetData& MaterialData = MaterialsData[MaterialIndex];
+
+			GatherTask.EnterProgressFrame(1.f, FText::FromString(MaterialData.AssetName.ToString()));
+
+			UMaterial* Material = Cast<UMaterial>(MaterialData.GetAsset());
+			if (!Material) continue;
+
+			TSharedPtr<FMaterialCostEntry> CostEntry = MakeShared<FMaterialCostEntry>();
+			CostEntry->AssetData = MaterialData;
+
+			for (int32 Usage = 0; Usage < MATUSAGE_MAX; Usage++)
+			{
+				CostEntry->NumUsageFlags += Material->GetUsageByFlag((EMaterialUsage)Usage) ? 1 : 0;
+			}
+
+			TArray<FMaterialParameterInfo> ParameterInfos;
+			TArray<FGuid> ParameterIds;
+
+			Material->GetAllParameterInfoOfType(EMaterialParameterType::StaticSwitch, ParameterInfos, ParameterIds);
+			CostEntry->NumStaticSwitches = ParameterInfos.Num();
+
+			Material->GetAllParameterInfoOfType(EMaterialParameterType::StaticComponentMask, ParameterInfos, ParameterIds);
+			CostEntry->NumStaticComponentMasks = ParameterInfos.Num();
+
+			//Every switch doubles the shader maps and every RGBA mask can take 16 values, clamped so huge graphs stay readable.
+			const int32 PermutationBits = FMath::Min(CostEntry->NumStaticSwitches + CostEntry->NumStaticComponentMasks * 4, 40);
+			CostEntry->NumPermutations = FMath::Max(CostEntry->NumUsageFlags, 1) * (int64(1) << PermutationBits);
+
+			const FMaterialStatistics Statistics = UMaterialEditingLibrary::GetStatistics(Material);
+			CostEntry->NumSamplers = Statistics.NumSamplers;
+			CostEntry->NumPixelInstructions = Statistics.NumPixelShaderInstructions;
+			CostEntry->NumVertexInstructions = Statistics.NumVertexShaderInstructions;
+
+			CostEntries.Add(CostEntry);
+		}
+
+		//Only asset data is kept, let the chunk go before loading the next one.
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		if (GatherTask.ShouldCancel())
+		{
+			DebugHeader::ShowNotifyInfo(FString::Printf(TEXT("Cancelled, reporting %d of %d materials"),
+				CostEntries.Num(), MaterialsData.Num()));
+			break;
+		}
+	}
+
+	return CostEntries;
+
+}//GatherMaterialCostEntries.
+
 #pragma endregion
 
 #pragma region ProccessDataForAdvanceDeletionTab
@@ -431,7 +862,8 @@ bool FSuperManagerModule::DeleteSingleAssetForAssetList(const FAssetData& AssetD
 
 bool FSuperManagerModule::DeleteMultipleAssetsForAssetList(const TArray<FAssetData>& AssetsToDelete)
 {
-	if (ObjectTools::DeleteAssets(AssetsToDelete) > 0)
+	//Packages proven unreferenced are removed without loading, only the rest go through ObjectTools.
+	if (FSafeAssetDeleter::DeleteAssets(AssetsToDelete) > 0)
 	{
 		return true;
 	}
@@ -440,53 +872,333 @@ bool FSuperManagerModule::DeleteMultipleAssetsForAssetList(const TArray<FAssetDa
 }//DeleteMultipleAssetsForAssetList.
 
 
-void FSuperManagerModule::ListUnusedAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutUnusedAssetsData)
+//An asset is used when something outside the list references it, or a used asset in the list does.
+//Maps and Asset Manager primary assets are roots, they are used however few reference them.
+//Chains and cycles only referenced from inside the list are unused as a whole.
+//Paths written in config, code and data files count as outside referencers.
+void FSuperManagerModule::ListUnusedAssetsForAssetList(const FAssetRowTable& AssetRows, const TArray<int32>& RowsToFilter, TArray<int32>& OutUnusedRows)
 {
-	OutUnusedAssetsData.Empty();
+	OutUnusedRows.Reset();
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TMap<FName, int32> IndexOfPackage;
+	IndexOfPackage.Reserve(RowsToFilter.Num());
+
+	for (int32 AssetIndex = 0; AssetIndex < RowsToFilter.Num(); AssetIndex++)
+	{
+		IndexOfPackage.Add(AssetRows.GetPackageName(RowsToFilter[AssetIndex]), AssetIndex);
+	}
+
+	//Referenced assets per listed asset, only references between listed assets.
+	TArray<TArray<int32>> ListedDependencies;
+	ListedDependencies.SetNum(RowsToFilter.Num());
+
+	TBitArray<> IsUsed(false, RowsToFilter.Num());
+	TArray<int32> UsedToVisit;
+
+	const FPathLiteralScanner PathLiteralScanner = ScanPathLiterals();
+
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	const FTopLevelAssetPath WorldClassPath = UWorld::StaticClass()->GetClassPathName();
 
-	for (const TSharedPtr<FAssetData>& DataSharedPtr : AssetsDataToFilter)
+	TArray<FName> Referencers;
+
+	for (int32 AssetIndex = 0; AssetIndex < RowsToFilter.Num(); AssetIndex++)
 	{
-		TArray<FString> AssetReferencers = 
-		UEditorAssetLibrary::FindPackageReferencersForAsset(DataSharedPtr->ObjectPath.ToString());
+		const FName PackageName = AssetRows.GetPackageName(RowsToFilter[AssetIndex]);
+
+		//Levels are opened by name and primary assets are loaded by id, neither needs a referencer to be used.
+		const bool bIsRoot = AssetRows.GetAssetClassPath(RowsToFilter[AssetIndex]) == WorldClassPath ||
+			(AssetManager && AssetManager->GetPrimaryAssetIdForPackage(PackageName).IsValid());
 
-		if (AssetReferencers.Num() ==0)
+		if (bIsRoot || PathLiteralScanner.IsReferenced(PackageName))
 		{
-			OutUnusedAssetsData.Add(DataSharedPtr);
+			IsUsed[AssetIndex] = true;
+			UsedToVisit.Add(AssetIndex);
+		}
+
+		Referencers.Reset();
+		AssetRegistry.GetReferencers(PackageName, Referencers, UE::AssetRegistry::EDependencyCategory::Package);
+
+		for (const FName& Referencer : Referencers)
+		{
+			if (Referencer == PackageName) continue;
+
+			if (const int32* ReferencerIndex = IndexOfPackage.Find(Referencer))
+			{
+				ListedDependencies[*ReferencerIndex].Add(AssetIndex);
+			}
+			else if (!IsUsed[AssetIndex])
+			{
+				IsUsed[AssetIndex] = true;
+				UsedToVisit.Add(AssetIndex);
+			}
+		}
+	}
+
+	//Everything a used asset references is used too.
+	while (UsedToVisit.Num() > 0)
+	{
+		const int32 UsedIndex = UsedToVisit.Pop(EAllowShrinking::No);
+
+		for (const int32 DependencyIndex : ListedDependencies[UsedIndex])
+		{
+			if (IsUsed[DependencyIndex]) continue;
+
+			IsUsed[DependencyIndex] = true;
+			UsedToVisit.Add(DependencyIndex);
+		}
+	}
+
+	for (int32 AssetIndex = 0; AssetIndex < RowsToFilter.Num(); AssetIndex++)
+	{
+		if (!IsUsed[AssetIndex])
+		{
+			OutUnusedRows.Add(RowsToFilter[AssetIndex]);
 		}
 	}
 
 }//ListUnusedAssetsForAssetList.
 
 
-void FSuperManagerModule::ListSameNameAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutSameNameAssetsData)
+void FSuperManagerModule::ListSameNameAssetsForAssetList(const FAssetRowTable& AssetRows, const TArray<int32>& RowsToFilter, TArray<int32>& OutSameNameRows)
+{
+	OutSameNameRows.Reset();
+
+	//Count first, then keep every row whose name was seen more than once, in listing order.
+	TMap<FName, int32> NumOfAssetsWithName;
+	NumOfAssetsWithName.Reserve(RowsToFilter.Num());
+
+	for (const int32 Row : RowsToFilter)
+	{
+		++NumOfAssetsWithName.FindOrAdd(AssetRows.GetAssetName(Row));
+	}
+
+	for (const int32 Row : RowsToFilter)
+	{
+		if (NumOfAssetsWithName[AssetRows.GetAssetName(Row)] > 1)
+		{
+			OutSameNameRows.Add(Row);
+		}
+	}
+
+}//ListSameNameAssetsForAssetList.
+
+void FSuperManagerModule::ListTextureMemoryForAssetList(const FAssetRowTable& AssetRows, const TArray<int32>& RowsToFilter, TArray<int32>& OutFlaggedTextureRows,
+	TMap<FName, FAssetListMetric>& OutMetrics)
 {
-	OutSameNameAssetsData.Empty();
+	OutFlaggedTextureRows.Reset();
+	OutMetrics.Empty();
+
+	const int32 MaxRecommendedSize = GetDefault<USuperManagerSettings>()->MaxRecommendedTextureSize;
 
-	//Multimap for supporting finding assets with same name
-	TMultiMap<FString, TSharedPtr<FAssetData> > AssetsInfoMultiMap;
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	//The table has no tags, the registry hands them out for the listed textures only.
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UTexture::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.PackageNames.Reserve(RowsToFilter.Num());
 
-	for (const TSharedPtr<FAssetData>& DataSharedPtr : AssetsDataToFilter)
+	for (const int32 Row : RowsToFilter)
 	{
-		AssetsInfoMultiMap.Emplace(DataSharedPtr->AssetName.ToString(), DataSharedPtr);
+		Filter.PackageNames.Add(AssetRows.GetPackageName(Row));
 	}
 
-	for (const TSharedPtr<FAssetData>& DataSharedPtr : AssetsDataToFilter)
+	if (Filter.PackageNames.Num() == 0) return;
+
+	AssetRegistry.EnumerateAssets(Filter, [&](const FAssetData& TextureData)
+		{
+			//Registry tags only, nothing is loaded.
+			FTextureMemoryEstimate Estimate;
+			if (!FTextureMemoryAudit::EstimateFromTags(TextureData, MaxRecommendedSize, Estimate)) return true;
+
+			if (Estimate.Flags == ETextureAuditFlags::None) return true;
+
+			const int32 Row = AssetRows.FindRow(TextureData.PackageName);
+			if (Row == INDEX_NONE) return true;
+
+			FAssetListMetric& Metric = OutMetrics.Add(TextureData.PackageName);
+			Metric.Value = Estimate.SavedBytes;
+			Metric.Text = FString::Printf(TEXT("%dx%d, %s resident, %s streaming, saves %s\n%s"),
+				Estimate.SizeX, Estimate.SizeY,
+				*FText::AsMemory(Estimate.ResidentBytes).ToString(),
+				*FText::AsMemory(Estimate.StreamingBytes).ToString(),
+				*FText::AsMemory(Estimate.SavedBytes).ToString(),
+				*FTextureMemoryAudit::DescribeFlags(Estimate.Flags));
+
+			OutFlaggedTextureRows.Add(Row);
+			return true;
+		});
+
+}//ListTextureMemoryForAssetList.
+
+TArray<FName> FSuperManagerModule::FixTexturesForAssetList(const TArray<FAssetData>& TexturesToFix)
+{
+	const TArray<FName> FixedPackageNames =
+		FTextureMemoryAudit::ApplyFixes(TexturesToFix, GetDefault<USuperManagerSettings>()->MaxRecommendedTextureSize);
+
+	if (FixedPackageNames.Num() > 0)
 	{
-		TArray< TSharedPtr <FAssetData> > OutAssetsData;
-		AssetsInfoMultiMap.MultiFind(DataSharedPtr->AssetName.ToString(), OutAssetsData);
+		DebugHeader::ShowNotifyInfo(TEXT("Fixed settings of ") + FString::FromInt(FixedPackageNames.Num()) + TEXT(" textures"));
+	}
+
+	return FixedPackageNames;
+
+}//FixTexturesForAssetList.
 
-		if (OutAssetsData.Num() <= 1) continue;
+void FSuperManagerModule::ListReferenceCyclesForAssetList(const FAssetRowTable& AssetRows, const TArray<int32>& RowsToFilter, TArray<int32>& OutRows,
+	TMap<FName, FAssetListMetric>& OutMetrics)
+{
+	OutRows.Reset();
+	OutMetrics.Empty();
+
+	TArray<FName> RootPackages;
+	RootPackages.Reserve(RowsToFilter.Num());
+
+	for (const int32 Row : RowsToFilter)
+	{
+		RootPackages.Add(AssetRows.GetPackageName(Row));
+	}
 
-		for (const TSharedPtr<FAssetData>& SameNameData : OutAssetsData)
+	FPackageDependencyGraph DependencyGraph;
+	DependencyGraph.Build(RootPackages);
+
+	TArray<int32> ComponentOfNode;
+	TArray<TArray<int32>> Components;
+	DependencyGraph.ComputeStronglyConnectedComponents(ComponentOfNode, Components);
+
+	TArray<TPair<int32, int32>> ClosingEdges;
+	int32 NumOfCycles = 0;
+
+	for (const TArray<int32>& Component : Components)
+	{
+		if (Component.Num() < 2) continue;
+
+		++NumOfCycles;
+
+		DependencyGraph.GetEdgesWithinComponent(Component, ComponentOfNode, ClosingEdges);
+
+		//Full report in the output log, the row only has room for a few edges.
+		FString EdgesText;
+		DebugHeader::PrintLog(FString::Printf(TEXT("Hard reference cycle %d, %d packages:"), NumOfCycles, Component.Num()));
+
+		for (int32 EdgeIndex = 0; EdgeIndex < ClosingEdges.Num(); EdgeIndex++)
 		{
-			if (SameNameData.IsValid())
+			const FString FromName = DependencyGraph.GetPackageName(ClosingEdges[EdgeIndex].Key).ToString();
+			const FString ToName = DependencyGraph.GetPackageName(ClosingEdges[EdgeIndex].Value).ToString();
+
+			DebugHeader::PrintLog(TEXT("    ") + FromName + TEXT(" -> ") + ToName);
+
+			if (EdgeIndex < 4)
 			{
-				OutSameNameAssetsData.AddUnique(SameNameData);
+				EdgesText += FString::Printf(TEXT("\n%s -> %s"), *FPackageName::GetShortName(FromName), *FPackageName::GetShortName(ToName));
 			}
 		}
+
+		if (ClosingEdges.Num() > 4)
+		{
+			EdgesText += FString::Printf(TEXT("\n... %d more in the output log"), ClosingEdges.Num() - 4);
+		}
+
+		const FString CycleText = FString::Printf(TEXT("Cycle %d of %d packages:%s"), NumOfCycles, Component.Num(), *EdgesText);
+
+		for (const int32 MemberNode : Component)
+		{
+			FAssetListMetric& Metric = OutMetrics.Add(DependencyGraph.GetPackageName(MemberNode));
+			Metric.Value = Component.Num();
+			Metric.Text = CycleText;
+		}
 	}
 
-}//ListSameNameAssetsForAssetList.
+	//Only listed assets are shown, cycle members outside the folder appear in the row text.
+	for (const int32 Row : RowsToFilter)
+	{
+		if (OutMetrics.Contains(AssetRows.GetPackageName(Row)))
+		{
+			OutRows.Add(Row);
+		}
+	}
+
+	if (NumOfCycles == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No hard reference cycle found"));
+	}
+
+}//ListReferenceCyclesForAssetList.
+
+void FSuperManagerModule::ListDependencyClosuresForAssetList(const FAssetRowTable& AssetRows, const TArray<int32>& RowsToFilter, TArray<int32>& OutRows,
+	TMap<FName, FAssetListMetric>& OutMetrics)
+{
+	OutRows.Reset();
+	OutMetrics.Empty();
+
+	FScopedSlowTask ClosureTask(2.f, FText::FromString(TEXT("Walking hard references")));
+	ClosureTask.MakeDialog();
+
+	TArray<FName> RootPackages;
+	RootPackages.Reserve(RowsToFilter.Num());
+
+	for (const int32 Row : RowsToFilter)
+	{
+		RootPackages.Add(AssetRows.GetPackageName(Row));
+	}
+
+	ClosureTask.EnterProgressFrame();
+	FPackageDependencyGraph DependencyGraph;
+	DependencyGraph.Build(RootPackages);
+
+	TArray<int32> RootRows;
+	TArray<int32> RootNodes;
+
+	for (const int32 Row : RowsToFilter)
+	{
+		const int32 Node = DependencyGraph.FindNode(AssetRows.GetPackageName(Row));
+		if (Node == INDEX_NONE) continue;
+
+		RootRows.Add(Row);
+		RootNodes.Add(Node);
+	}
+
+	ClosureTask.EnterProgressFrame(1.f, FText::FromString(FString::Printf(TEXT("Sizing closures of %d packages"), DependencyGraph.Num())));
+	const TArray<FPackageDependencyGraph::FClosureSize> ClosureSizes = DependencyGraph.ComputeClosureSizes(RootNodes);
+
+	for (int32 RootIndex = 0; RootIndex < RootRows.Num(); RootIndex++)
+	{
+		const int32 Row = RootRows[RootIndex];
+		const FPackageDependencyGraph::FClosureSize& ClosureSize = ClosureSizes[RootIndex];
+
+		FAssetListMetric& Metric = OutMetrics.FindOrAdd(AssetRows.GetPackageName(Row));
+		Metric.Value = ClosureSize.DiskBytes;
+		Metric.Text = FString::Printf(TEXT("Loads %d packages, %s on disk"),
+			ClosureSize.NumPackages, *FText::AsMemory(ClosureSize.DiskBytes).ToString());
+
+		OutRows.Add(Row);
+	}
+
+}//ListDependencyClosuresForAssetList.
+
+FPathLiteralScanner FSuperManagerModule::ScanPathLiterals()
+{
+	FScopedSlowTask ScanTask(1.f, FText::FromString(TEXT("Searching config and source files for asset paths")));
+	ScanTask.MakeDialog();
+	ScanTask.EnterProgressFrame();
+
+	const double ScanStartTime = FPlatformTime::Seconds();
+
+	FPathLiteralScanner PathLiteralScanner;
+	PathLiteralScanner.Scan();
+
+	DebugHeader::PrintLog(FString::Printf(TEXT("%d files mention %d packages by path (searched in %.2f s)"),
+		PathLiteralScanner.GetScannedFiles().Num(), PathLiteralScanner.GetNumOfReferencedPackages(),
+		FPlatformTime::Seconds() - ScanStartTime));
+
+	return PathLiteralScanner;
+
+}//ScanPathLiterals.
 
 void FSuperManagerModule::SyncCBToClickedAssetForAssetList(const FString& AssetPathToSync)
 {
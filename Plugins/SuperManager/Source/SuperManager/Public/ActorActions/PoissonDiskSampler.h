@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Grid accelerated Poisson-disk sampler on the XY plane.
+ * The domain is split into tiles that are processed in four phases (2x2 colouring),
+ * tiles sharing a phase are far enough apart to be sampled on worker threads without locks.
+ */
+class SUPERMANAGER_API FPoissonDiskSampler
+{
+public:
+
+	//Fills OutPoints with points at least MinDistance apart inside Bounds that pass IsPointInside.
+	//Same seed and inputs always give the same points. Returns false if the grid would be too large.
+	static bool GeneratePoints(const FBox2D& Bounds, float MinDistance, int32 Seed,
+		TFunctionRef<bool(const FVector2D&)> IsPointInside, TArray<FVector2D>& OutPoints,
+		int32 MaxAttemptsPerCell = 30);
+
+private:
+
+	//Cells per tile side, must be larger than the 2 cell neighbourhood a sample checks.
+	static constexpr int32 TileSizeInCells = 8;
+
+	static constexpr int64 MaxGridCells = 64 * 1024 * 1024;
+};
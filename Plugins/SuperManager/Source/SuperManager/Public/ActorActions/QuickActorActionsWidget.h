@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "EditorUtilityWidget.h"
+#include "Containers/Ticker.h"
+#include "WorldCollision.h"
 #include "QuickActorActionsWidget.generated.h"
 
 UENUM(BlueprintType)
@@ -54,6 +56,16 @@ struct FRandomActorRotation
 	float RotRollMax = 45.f;
 };
 
+//Random values drawn for one actor, always five per actor so toggling one condition won't shift the others.
+struct FRandomTransformSample
+{
+	float Yaw = 0.f;
+	float Pitch = 0.f;
+	float Roll = 0.f;
+	float Scale = 1.f;
+	float Offset = 0.f;
+};
+
 /**
  * 
  */
@@ -120,11 +132,79 @@ public:
 	float OffsetMax = 50.f;
 
 
+	//When unchecked a new seed is picked and written back to RandomSeed on every run.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RandomizeActorTransform")
+	bool bUseFixedSeed = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RandomizeActorTransform", meta = (EditCondition = "bUseFixedSeed"))
+	int32 RandomSeed = 0;
+
 	UFUNCTION(BlueprintCallable, Category = "RandomizeActorTransform")
 	void Randomize();
 
 
 
+#pragma endregion
+
+#pragma region ActorScatter
+
+	//Minimum distance between two scattered points.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorScatter", meta = (ClampMin = "1.0"))
+	float ScatterMinDistance = 200.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorScatter", meta = (ClampMin = "1"))
+	int32 ScatterMaxPoints = 100000;
+
+	//Add all points as instances of the template mesh on one actor instead of spawning an actor per point.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorScatter")
+	bool bScatterAsInstances = true;
+
+	//Apply the rotation, scale and offset ranges of RandomizeActorTransform to every scattered point.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorScatter")
+	bool bRandomizeScatteredTransforms = true;
+
+	//Select the actor to scatter and a volume (or an actor with a closed spline) to scatter inside.
+	UFUNCTION(BlueprintCallable, Category = "ActorScatter")
+	void ScatterActors();
+
+#pragma endregion
+
+#pragma region DropToSurface
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DropToSurface", meta = (ClampMin = "1.0"))
+	float DropTraceDistance = 100000.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DropToSurface")
+	TEnumAsByte<ECollisionChannel> DropTraceChannel = ECC_Visibility;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DropToSurface")
+	bool bAlignToSurfaceNormal = false;
+
+	//Traces down from every selected actor as one async batch, then snaps them all in one transaction.
+	UFUNCTION(BlueprintCallable, Category = "DropToSurface")
+	void DropActorsToSurface();
+
+#pragma endregion
+
+#pragma region DuplicateActorAudit
+
+	//Actors closer than this (in cm) are treated as sitting at the same location.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DuplicateActorAudit", meta = (ClampMin = "0.01"))
+	float DuplicateLocationTolerance = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DuplicateActorAudit", meta = (ClampMin = "0.01"))
+	float DuplicateRotationTolerance = 0.1f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DuplicateActorAudit", meta = (ClampMin = "0.0001"))
+	float DuplicateScaleTolerance = 0.01f;
+
+	//Selects every extra copy of actors stacked on the same mesh and transform, keeping one of each stack unselected.
+	UFUNCTION(BlueprintCallable, Category = "DuplicateActorAudit")
+	void SelectOverlappingDuplicates();
+
+	UFUNCTION(BlueprintCallable, Category = "DuplicateActorAudit")
+	void DeleteOverlappingDuplicates();
+
 #pragma endregion
 
 
@@ -135,6 +215,77 @@ private:
 
 	bool GetEditorActorSubsystem();
 
+#pragma region RandomizeActorTransformCore
+
+	bool HasRandomizeConditionSet() const;
+
+	void GenerateRandomTransformSamples(int32 Seed, int32 NumOfSamples, TArray<FRandomTransformSample>& OutSamples) const;
+
+	FTransform ApplyRandomTransformSample(const FTransform& BaseTransform, const FRandomTransformSample& Sample) const;
+
+#pragma endregion
+
+#pragma region ActorScatterCore
+
+	bool FindScatterTemplateAndVolume(const TArray<AActor*>& SelectedActors, AActor*& OutTemplateActor, AActor*& OutVolumeActor);
+
+	bool GenerateScatterPoints(AActor* VolumeActor, int32 Seed, TArray<FVector>& OutPoints);
+
+	int32 SpawnScatteredActors(AActor* TemplateActor, const TArray<FTransform>& ScatterTransforms);
+
+	int32 SpawnScatteredInstances(AActor* TemplateActor, const TArray<FTransform>& ScatterTransforms);
+
+#pragma endregion
+
+#pragma region DropToSurfaceCore
+
+	struct FPendingDropTrace
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FVector TraceStart = FVector::ZeroVector;
+		FVector TraceEnd = FVector::ZeroVector;
+		//Distance from the actor's pivot down to the bottom of its bounds.
+		double PivotHeight = 0.0;
+		bool bCompleted = false;
+		bool bHit = false;
+		FVector ImpactPoint = FVector::ZeroVector;
+		FVector ImpactNormal = FVector::UpVector;
+	};
+
+	TArray<FPendingDropTrace> PendingDropTraces;
+
+	TWeakObjectPtr<UWorld> DropTraceWorld;
+
+	FTraceDelegate DropTraceDelegate;
+
+	FTSTicker::FDelegateHandle DropTraceTickerHandle;
+
+	int32 NumOfDropTracesCompleted = 0;
+
+	int32 NumOfDropTraceFramesWaited = 0;
+
+	double DropTraceStartTime = 0.0;
+
+	//Frames to wait for the async trace pipeline before tracing the rest synchronously.
+	static constexpr int32 MaxDropTraceFramesToWait = 30;
+
+	void OnDropTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceData);
+
+	bool TickPendingDropTraces(float DeltaTime);
+
+	void ApplyDropTraceResults(int32 NumOfSynchronousTraces);
+
+#pragma endregion
+
+#pragma region DuplicateActorAuditCore
+
+	//Groups of coincident actors, the first actor of every group is the one to keep.
+	void FindOverlappingDuplicates(TArray<TArray<AActor*>>& OutDuplicateGroups);
+
+	void GetExtraDuplicateCopies(const TArray<TArray<AActor*>>& DuplicateGroups, TArray<AActor*>& OutExtraCopies);
+
+#pragma endregion
+
 
 
 
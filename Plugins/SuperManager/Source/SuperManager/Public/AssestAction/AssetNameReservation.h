@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Answers name collision checks from the Asset Registry.
+ * A reservation lists each folder once per job, so later checks and reservations are set lookups.
+ */
+class SUPERMANAGER_API FAssetNameReservation
+{
+public:
+
+	//One package name lookup, includes assets created in memory and not saved yet.
+	static bool IsNameUsed(const FString& PackagePath, const FString& AssetName);
+
+	//Returns false when the name is already used on disk or reserved earlier in this job.
+	bool Reserve(const FString& PackagePath, const FString& AssetName);
+
+	//Reserves BaseName, or BaseName_1, BaseName_2 ... if it is taken.
+	FString ReserveUnique(const FString& PackagePath, const FString& BaseName);
+
+private:
+
+	//FName keys, asset names are case insensitive like the packages holding them.
+	TMap<FName, TSet<FName>> UsedNamesByFolder;
+
+	//Next numbered suffix to try per folder and base name, so repeated requests do not rescan from _1.
+	TMap<FString, int32> NextSuffixByBaseName;
+
+	TSet<FName>& GetUsedNames(const FString& PackagePath);
+};
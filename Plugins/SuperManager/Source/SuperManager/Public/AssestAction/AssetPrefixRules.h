@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/TopLevelAssetPath.h"
+
+struct FAssetData;
+
+/**
+ * Resolves naming prefixes from Asset Registry class paths, so assets never have to be loaded to be named.
+ * A class without its own prefix takes the one of its nearest ancestor, resolved once per class.
+ */
+class SUPERMANAGER_API FAssetPrefixRules
+{
+public:
+
+	//Reads the prefix table from the Super Manager project settings.
+	FAssetPrefixRules();
+
+	//Prefix for the class or its nearest ancestor, nullptr when none of them has one.
+	const FString* ResolvePrefix(const FTopLevelAssetPath& ClassPath);
+
+	//Prefix for an asset, blueprints are resolved through their parent class first so widget blueprints get their own.
+	const FString* ResolvePrefix(const FAssetData& AssetData);
+
+	//Returns false when the asset has no prefix or its name already starts with it.
+	bool MakePrefixedName(const FAssetData& AssetData, FString& OutNewName);
+
+	//Name the asset gets once Prefix is added, material instances drop their old M_ and _Inst.
+	static FString ApplyPrefix(const FAssetData& AssetData, const FString& Prefix);
+
+	//Indices of the assets whose names miss their prefix, OutPrefixes holds the prefix each index should get.
+	//Prefixes are resolved once per distinct class and parent class, the lookups and names are then checked in parallel shards.
+	TArray<int32> FindNamingViolations(const TArray<FAssetData>& AssetsData, TArray<const FString*>& OutPrefixes);
+
+	//Renames every asset in one AssetTools call, then fixes up only the redirectors it left behind.
+	//Returns the number of assets renamed.
+	static int32 RenameAssets(const TArray<FAssetData>& AssetsToRename, const TArray<FString>& NewNames);
+
+private:
+
+	//Parent class of a blueprint from its registry tag, invalid for everything else.
+	static FTopLevelAssetPath GetParentClassPath(const FAssetData& AssetData);
+
+	TMap<FTopLevelAssetPath, FString> PrefixByClassPath;
+
+	//Memoized class to prefix lookups, pointing into PrefixByClassPath. nullptr means no ancestor has a prefix.
+	TMap<FTopLevelAssetPath, const FString*> ResolvedPrefixes;
+};
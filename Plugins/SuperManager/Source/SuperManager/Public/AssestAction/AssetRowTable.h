@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+enum class EAssetRowFlags : uint8
+{
+	None = 0,
+
+	//Deleted from the tab, the row stays so indices handed out earlier keep their meaning.
+	Deleted = 1 << 0,
+};
+ENUM_CLASS_FLAGS(EAssetRowFlags)
+
+/**
+ * The few asset fields the Advance Deletion tab shows and filters on, one column per field.
+ * Rows are only added while the table is built and are never moved, so a row index or item stays valid for the table's lifetime.
+ * Anything else, tags included, is looked up in the Asset Registry for the rows that need it.
+ */
+class SUPERMANAGER_API FAssetRowTable
+{
+public:
+
+	//What the list view holds for a row. It points at the row's package name, so it dereferences to the metric key.
+	typedef const FName* FRowItem;
+
+	void Reserve(int32 NumOfRows);
+
+	int32 AddRow(const FAssetData& AssetData);
+
+	int32 Num() const { return PackageNames.Num(); }
+
+	FName GetPackageName(int32 Row) const { return PackageNames[Row]; }
+
+	FName GetAssetName(int32 Row) const { return AssetNames[Row]; }
+
+	const FTopLevelAssetPath& GetAssetClassPath(int32 Row) const { return ClassPaths[ClassIndices[Row]]; }
+
+	FSoftObjectPath GetObjectPath(int32 Row) const { return FSoftObjectPath(FTopLevelAssetPath(PackageNames[Row], AssetNames[Row])); }
+
+	//Full registry entry of the row, invalid once the asset is gone.
+	FAssetData GetAssetData(int32 Row) const;
+
+	bool HasFlags(int32 Row, EAssetRowFlags FlagsToCheck) const { return EnumHasAnyFlags(Flags[Row], FlagsToCheck); }
+
+	void MarkDeleted(int32 Row) { Flags[Row] |= EAssetRowFlags::Deleted; }
+
+	//INDEX_NONE when the package has no row.
+	int32 FindRow(FName PackageName) const;
+
+	//Every row not deleted, in the order they were added.
+	void GetLiveRows(TArray<int32>& OutRows) const;
+
+	FRowItem GetItem(int32 Row) const { return &PackageNames[Row]; }
+
+	int32 GetRow(FRowItem Item) const { return UE_PTRDIFF_TO_INT32(Item - PackageNames.GetData()); }
+
+private:
+
+	TArray<FName> PackageNames;
+
+	TArray<FName> AssetNames;
+
+	//Few distinct classes, each row keeps an index into them.
+	TArray<int32> ClassIndices;
+
+	TArray<EAssetRowFlags> Flags;
+
+	TArray<FTopLevelAssetPath> ClassPaths;
+
+	TMap<FTopLevelAssetPath, int32> ClassIndexByPath;
+
+	TMap<FName, int32> RowByPackageName;
+};
@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "AssetRegistry/AssetData.h"
+
+class FAssetPrefixRules;
+
+/**
+ * Keeps unused asset, empty folder and naming results for /Game fresh while the editor idles.
+ * Works one registry call at a time from the core ticker and stops each tick once the budget from the project settings is spent.
+ * A finished pass is kept up to date by update passes over the folders that changed, a running pass is never restarted by them.
+ * Only an edit of the prefix table starts over from the root.
+ */
+class SUPERMANAGER_API FBackgroundAssetAuditor
+{
+public:
+
+	struct FNamingViolation
+	{
+		FAssetData AssetData;
+
+		FString Prefix;
+	};
+
+	FBackgroundAssetAuditor();
+
+	~FBackgroundAssetAuditor();
+
+	//True when the last finished pass saw the registry as it is now.
+	bool IsUpToDate() const { return bHasResults && !bNeedsFullPass && ChangedFolders.Num() == 0 && Phase == EAuditPhase::Idle; }
+
+	//Up to date and FolderPath is inside the audited root, anything else was never scanned.
+	bool CanAnswerFor(const FString& FolderPath) const;
+
+	TArray<FAssetData> GetUnusedAssetsUnder(const FString& FolderPath) const;
+
+	TArray<FString> GetEmptyFoldersUnder(const FString& FolderPath) const;
+
+	TArray<FNamingViolation> GetNamingViolationsUnder(const FString& FolderPath) const;
+
+private:
+
+	enum class EAuditPhase : uint8
+	{
+		Idle,
+		ScanFolders,
+		UpdateFolders
+	};
+
+	struct FAuditResults
+	{
+		TArray<FAssetData> UnusedAssets;
+
+		TArray<FString> EmptyFolders;
+
+		TArray<FNamingViolation> NamingViolations;
+	};
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	EAuditPhase Phase = EAuditPhase::Idle;
+
+	bool bNeedsFullPass = true;
+
+	bool bHasResults = false;
+
+	FAuditResults PublishedResults;
+
+	FAuditResults WorkingResults;
+
+	//Cursor of the pass in progress. Folders are discovered as the pass goes, one level per folder.
+	TArray<FString> FoldersToScan;
+	int32 NextFolderIndex = 0;
+	bool bSubPathsListed = false;
+	TArray<FAssetData> CurrentFolderAssets;
+	int32 NextAssetIndex = 0;
+
+	TSet<FString> NonEmptyFolders;
+
+	//Seen while a pass runs or after it finished, audited by the next update pass.
+	TSet<FName> ChangedPackages;
+	TSet<FString> ChangedFolders;
+
+	TArray<FName> Referencers;
+
+	TUniquePtr<FAssetPrefixRules> PrefixRules;
+
+	bool Tick(float DeltaTime);
+
+	void StartPass();
+
+	void StartUpdatePass();
+
+	void AuditAsset(const FAssetData& AssetData);
+
+	void FinishPass();
+
+	void OnAssetChanged(const FAssetData& AssetData);
+
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	void OnPathChanged(const FString& Path) { ChangedFolders.Add(Path); }
+
+	void OnSettingsChanged(UObject* Settings, struct FPropertyChangedEvent& PropertyChangedEvent);
+
+	static bool IsExcludedPath(const FString& Path);
+
+	static bool IsUnderFolder(const FString& Path, const FString& FolderPath);
+};
@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UMaterial;
+class UMaterialExpression;
+class UMaterialExpressionTextureBase;
+struct FExpressionInput;
+
+/**
+ * Canonical hash of a material's expression graph.
+ * The graph is walked from the material outputs, so node order, node positions, comments and
+ * dangling nodes do not matter. Which textures are sampled does not matter either, only how.
+ */
+class SUPERMANAGER_API FMaterialGraphHasher
+{
+public:
+
+	//OutTextureExpressions receives every texture node in walk order, which is the same order for every
+	//material with the same hash.
+	static uint64 HashMaterial(UMaterial* Material, TArray<UMaterialExpressionTextureBase*>* OutTextureExpressions = nullptr);
+
+private:
+
+	TMap<UMaterialExpression*, uint64> ExpressionHashes;
+
+	TArray<UMaterialExpressionTextureBase*>* TextureExpressions = nullptr;
+
+	uint64 HashInput(const FExpressionInput* Input);
+
+	uint64 HashExpression(UMaterialExpression* Expression);
+
+	static uint64 HashExpressionProperties(UMaterialExpression* Expression);
+
+	static uint64 Combine(uint64 Hash, uint64 Value);
+
+	static uint64 HashString(const FString& String);
+};
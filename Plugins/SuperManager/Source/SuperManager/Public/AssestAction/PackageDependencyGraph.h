@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Hard package dependencies from the Asset Registry, flattened into index arrays.
+ * Script packages are left out, they are always loaded and have no size on disk.
+ */
+class SUPERMANAGER_API FPackageDependencyGraph
+{
+public:
+
+	struct FClosureSize
+	{
+		int32 NumPackages = 0;
+
+		int64 DiskBytes = 0;
+	};
+
+	//Adds RootPackages and every package they reach through hard references.
+	void Build(const TArray<FName>& RootPackages);
+
+	int32 Num() const { return PackageNames.Num(); }
+
+	//INDEX_NONE when the package is not in the graph.
+	int32 FindNode(FName PackageName) const;
+
+	FName GetPackageName(int32 Node) const { return PackageNames[Node]; }
+
+	const TArray<int32>& GetDependencies(int32 Node) const { return Dependencies[Node]; }
+
+	//Iterative Tarjan, linear in nodes and edges. Components come out dependencies first, so every edge
+	//leaving a component points at one with a lower index. Returns the number of components.
+	int32 ComputeStronglyConnectedComponents(TArray<int32>& OutComponentOfNode, TArray<TArray<int32>>& OutComponents) const;
+
+	//Edges between members of one component, the references that close its cycles.
+	void GetEdgesWithinComponent(const TArray<int32>& Component, const TArray<int32>& ComponentOfNode, TArray<TPair<int32, int32>>& OutEdges) const;
+
+	//Packages and bytes on disk loaded along with each of Nodes, the node itself included, in the order of Nodes.
+	//A cycle is walked once and shared by all of its members. Closures are kept as sparse component lists
+	//under a fixed budget, components past it are walked only when one of Nodes reaches them.
+	TArray<FClosureSize> ComputeClosureSizes(const TArray<int32>& Nodes) const;
+
+private:
+
+	TArray<FName> PackageNames;
+
+	TMap<FName, int32> NodeByPackageName;
+
+	TArray<TArray<int32>> Dependencies;
+
+	TArray<int64> DiskSizes;
+
+	int32 AddNode(FName PackageName);
+};
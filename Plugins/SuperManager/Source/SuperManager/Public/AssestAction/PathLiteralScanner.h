@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Finds asset paths written out as text, in config, code and data files, which the Asset Registry never sees.
+ * Scans Config/ and Source/ of the project and of every project plugin for literals starting at a project content mount point,
+ * such as /Game/Maps/Entry or "/Game/UI/WBP_Menu.WBP_Menu_C", and keeps which files mention each package.
+ */
+class SUPERMANAGER_API FPathLiteralScanner
+{
+public:
+
+	//Maps or reads every text file and searches them on worker threads.
+	void Scan();
+
+	bool IsReferenced(FName PackageName) const { return FilesByPackage.Contains(PackageName); }
+
+	//Indices into GetScannedFiles, nullptr when no file mentions the package.
+	const TArray<int32>* FindReferencingFiles(FName PackageName) const { return FilesByPackage.Find(PackageName); }
+
+	const TArray<FString>& GetScannedFiles() const { return ScannedFiles; }
+
+	int32 GetNumOfReferencedPackages() const { return FilesByPackage.Num(); }
+
+private:
+
+	TArray<FString> ScannedFiles;
+
+	TMap<FName, TArray<int32>> FilesByPackage;
+
+	static void GatherTextFiles(TArray<FString>& OutFiles);
+
+	static void ScanText(const uint8* Text, int64 TextSize, const TArray<TArray<ANSICHAR>>& MountPoints, TSet<FString>& OutPackageNames);
+};
@@ -5,8 +5,14 @@
 #include "CoreMinimal.h"
 #include "EditorUtilityWidget.h"
 #include "Materials/MaterialExpressionTextureSample.h"
+#include "Engine/DataTable.h"
+#include "AssestAction/TextureSuffixMatcher.h"
+#include "AssestAction/TextureSettingsBatch.h"
 #include "QuickMaterialWidget.generated.h"
 
+class UTexture;
+class FAssetNameReservation;
+
 
 UENUM(BlueprintType)
 enum class E_ChannelPackingType : uint8
@@ -18,6 +24,30 @@ enum class E_ChannelPackingType : uint8
 	ECPT_MAX UMETA (DisplayName = "DefaultMax")
 };
 
+//One material instance to generate, the row name becomes the instance name.
+USTRUCT(BlueprintType)
+struct FMaterialInstanceVariantRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstanceVariant")
+	TMap<FName, float> ScalarOverrides;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstanceVariant")
+	TMap<FName, FLinearColor> VectorOverrides;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstanceVariant")
+	TMap<FName, TSoftObjectPtr<UTexture>> TextureOverrides;
+};
+
+//Textures under one folder that share a name once the role suffix is stripped.
+struct FTextureSetGroup
+{
+	FString BaseName;
+	FString PackagePath;
+	TArray<FAssetData> TexturesData;
+};
+
 /**
  * 
  */
@@ -41,6 +71,14 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CreateMaterialFromSelectedTextures",meta = (EditCondition = "bCustomMaterialName"))
 	FString MaterialName = TEXT("M_");
+
+	//In ORM mode, separate AO, Roughness and Metallic maps are packed into one texture before wiring.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CreateMaterialFromSelectedTextures")
+	bool bPackSeparateMapsToORM = true;
+
+	//Appended to the texture set name, must be one of the ORMArray suffixes.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CreateMaterialFromSelectedTextures", meta = (EditCondition = "bPackSeparateMapsToORM"))
+	FString PackedORMSuffix = TEXT("_ORM");
 	
 	
 	
@@ -48,8 +86,82 @@ public:
 	UFUNCTION(Blueprintcallable, Category = "CreateMaterialFromSelectedTextures")
 	void CreateMaterialFromSelectedTextures();
 
+	//Packs the selected AO, Roughness and Metallic textures into one ORM texture next to them.
+	UFUNCTION(Blueprintcallable, Category = "CreateMaterialFromSelectedTextures")
+	void PackSelectedTexturesToORM();
+
+
+
+
+#pragma endregion
+
+#pragma region BatchMaterialCreation
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BatchMaterialCreation")
+	FString BatchTextureFolder = TEXT("/Game");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BatchMaterialCreation")
+	bool bBatchIncludeSubfolders = true;
+
+	//Creates one material (and instance if enabled) for every texture set found under BatchTextureFolder.
+	UFUNCTION(Blueprintcallable, Category = "BatchMaterialCreation")
+	void CreateMaterialsFromTextureFolder();
+
+#pragma endregion
+
+#pragma region MaterialInstanceVariants
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstanceVariants")
+	TObjectPtr<UMaterialInterface> VariantParentMaterial;
+
+	//Rows must use FMaterialInstanceVariantRow.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstanceVariants")
+	TObjectPtr<UDataTable> VariantTable;
+
+	//Used when no table is set, same columns as FMaterialInstanceVariantRow.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstanceVariants", meta = (FilePathFilter = "csv"))
+	FFilePath VariantCSVFile;
+
+	//Leave empty to create the instances next to the parent material.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstanceVariants")
+	FString VariantOutputFolder;
+
+	UFUNCTION(Blueprintcallable, Category = "MaterialInstanceVariants")
+	void CreateMaterialInstanceVariants();
+
+#pragma endregion
+
+#pragma region MaterialGraphAudit
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialGraphAudit")
+	FString MaterialAuditFolder = TEXT("/Game");
 
+	//Logs every group of materials whose graphs only differ in the textures they sample.
+	UFUNCTION(Blueprintcallable, Category = "MaterialGraphAudit")
+	void FindStructurallyDuplicateMaterials();
 
+	//Keeps one master per group, turns its textures into parameters and replaces the rest with instances of it.
+	UFUNCTION(Blueprintcallable, Category = "MaterialGraphAudit")
+	void CollapseDuplicateMaterialsToInstances();
+
+#pragma endregion
+
+#pragma region TextureRoleAnalysis
+
+	//Textures whose names match no supported suffix are classified from their pixels while wiring.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TextureRoleAnalysis")
+	bool bUsePixelAnalysisForUnmatchedNames = true;
+
+	//Otherwise the analysis only reports textures with a wrong role or wrong settings.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TextureRoleAnalysis")
+	bool bApplySuggestedTextureSettings = false;
+
+	UFUNCTION(Blueprintcallable, Category = "TextureRoleAnalysis")
+	void AnalyzeSelectedTextureRoles();
+
+	//Analyses every texture under BatchTextureFolder.
+	UFUNCTION(Blueprintcallable, Category = "TextureRoleAnalysis")
+	void AnalyzeTextureRolesUnderFolder();
 
 #pragma endregion
 
@@ -99,16 +211,54 @@ public:
 
 #pragma endregion
 
+#pragma region Diagnostics
+
+	//Times the old per-array substring scan against the compiled suffix matcher over 100k generated names.
+	UFUNCTION(Blueprintcallable, Category = "Diagnostics")
+	void BenchmarkTextureNameClassification();
+
+#pragma endregion
+
 private:
 
 #pragma region QuickMaterialCreationCore
 
 	bool ProcessSelectedData(const TArray<FAssetData>& SelectedDataToProcess, TArray<UTexture2D*>& OutSelectedTexturesArray, FString& OutSelectedTexturePackagePath);
 
-	bool CheckIsNameUsed(const FString& FolderPathToCheck, const FString& MaterialNameToCheck);
+	void GroupTextureSetsUnderFolder(const FString& FolderPathToScan, TArray<FTextureSetGroup>& OutTextureSets);
+
+	FTextureSuffixMatcher SuffixMatcher;
+
+	uint32 SuffixMatcherSignature = 0;
+
+	bool bSuffixMatcherCompiled = false;
+
+	void CompileSuffixMatcherIfChanged();
+
+	ETextureRole ResolveTextureRole(UTexture2D* Texture);
+
+	//Pixel roles of the textures being wired whose names match no suffix, filled once per material.
+	TMap<TObjectKey<UTexture2D>, ETextureRole> PixelRolesOfUnmatchedTextures;
+
+	void AnalyzeUnmatchedTextureRoles(const TArray<UTexture2D*>& Textures);
+
+	void AnalyzeAndReportTextureRoles(const TArray<FAssetData>& TexturesData);
+
+	UTexture2D* PackSeparateMapsToORM(TArray<UTexture2D*>& InOutTextures, bool bShowMsgOnFail = false);
+
+	bool CheckIsNameUsed(const FString& FolderPathToCheck, const FString& MaterialNameToCheck, bool bShowMsgWhenUsed = true);
 
 	UMaterial* CreateMaterialAsset(const FString& NameOfTheMaterial, const FString& PathToPutMaterial);
 
+	//Texture setting changes requested while wiring pins, applied together instead of one rebuild per pin.
+	FTextureSettingsBatch PendingTextureSettings;
+
+	double AssembleAndCompileMaterial(UMaterial* CreatedMaterial, const TArray<UTexture2D*>& TexturesToConnect, uint32& PinsConnectedCounter);
+
+	void AssembleMaterialGraph(UMaterial* CreatedMaterial, const TArray<UTexture2D*>& TexturesToConnect, uint32& PinsConnectedCounter);
+
+	double CompileCreatedMaterial(UMaterial* CreatedMaterial);
+
 	void Default_CreateMaterialNodes(UMaterial* CreatedMaterial, UTexture2D* SelectedTexture, uint32& PinsConnectedCounter);
 
 	void ORM_CreateMaterialNodes(UMaterial* CreatedMaterial, UTexture2D* SelectedTexture, uint32& PinsConnectedCounter);
@@ -118,20 +268,33 @@ private:
 
 #pragma region CreateMaterialNodesConnectedPins
 
-	bool TryConnectBaseColor(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial);
+	bool TryConnectBaseColor(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial, ETextureRole TextureRole);
 
-	bool TryConnectMetallic(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial);
+	bool TryConnectMetallic(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial, ETextureRole TextureRole);
 
-	bool TryConnectRoughness(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial);
+	bool TryConnectRoughness(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial, ETextureRole TextureRole);
 
-	bool TryConnectNormal(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial);
+	bool TryConnectNormal(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial, ETextureRole TextureRole);
 
-	bool TryConnectAO(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial);
+	bool TryConnectAO(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial, ETextureRole TextureRole);
 
-	bool TryConnectORM(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial);
+	bool TryConnectORM(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial, ETextureRole TextureRole);
 
 #pragma endregion
 
+	UDataTable* LoadVariantTable();
+
+	void GatherStructurallyDuplicateMaterials(TArray<TArray<UMaterial*>>& OutClusters);
+
+	bool CollapseMaterialCluster(const TArray<UMaterial*>& Cluster, FAssetNameReservation& NameReservation, TArray<UPackage*>& OutPackagesToSave);
+
+	class UMaterialExpressionTextureSampleParameter2D* ConvertTextureSampleToParameter(UMaterial* Material,
+		UMaterialExpressionTextureSample* TextureSampleNode, FName ParameterName);
+
+	class UMaterialInstanceConstant* CreateMaterialInstanceVariant(UMaterialInterface* ParentMaterial, const FString& NameOfMaterialInstance,
+		const FString& PathToPutMI, const FMaterialInstanceVariantRow& VariantRow, const TSet<FName>& KnownParameterNames, uint32& UnknownOverridesCounter,
+		uint32& FailedTextureLoadsCounter);
+
 	class UMaterialInstanceConstant* CreateMaterialInstanceAsset(UMaterial* CreatedMaterial,FString NameOfMaterialInstance,const FString& PathToPutMI);
 
 };
@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/**
+ * Deletes assets without loading the packages it can prove nothing uses.
+ * A package is proven when the registry has no referencer for it outside the assets being deleted, it is not loaded
+ * (so nothing in memory points at it and no editor has it open), and its file can simply be removed.
+ * Everything else takes the regular ObjectTools path, which loads and checks references itself.
+ */
+class SUPERMANAGER_API FSafeAssetDeleter
+{
+public:
+
+	//Returns how many of AssetsToDelete are gone, by either path.
+	static int32 DeleteAssets(const TArray<FAssetData>& AssetsToDelete);
+
+	static void PartitionProvenUnreferenced(const TArray<FAssetData>& AssetsToDelete,
+		TArray<FAssetData>& OutProvenUnreferenced, TArray<FAssetData>& OutNeedsFullDelete);
+
+private:
+
+	//Removes the package files and tells the registry in one rescan. Assets whose file could not be deleted go to OutFailed.
+	static int32 DeletePackageFiles(const TArray<FAssetData>& ProvenUnreferenced, TArray<FAssetData>& OutFailed);
+};
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+struct FSourceChangeReport
+{
+	//Assets with at least one source file whose content no longer matches the hash stored at import.
+	TArray<FAssetData> ChangedAssets;
+
+	TArray<FString> MissingSourceFiles;
+
+	//Imported assets without a stored hash, they cannot be compared.
+	int32 NumOfUnhashedAssets = 0;
+
+	int32 NumOfCheckedAssets = 0;
+
+	int32 NumOfHashedFiles = 0;
+};
+
+/**
+ * Tells which imported assets have a changed source file, from the import data in the registry tags and the files on disk.
+ * Nothing is loaded until the changed assets are reimported.
+ */
+class SUPERMANAGER_API FSourceChangeDetector
+{
+public:
+
+	//Hashes every source file once, on worker threads.
+	static FSourceChangeReport FindChangedSources(const TArray<FAssetData>& AssetsData);
+
+	//Loads, reimports and saves BatchSize assets at a time, memory is released between batches. Returns how many reimported.
+	static int32 ReimportInBatches(const TArray<FAssetData>& AssetsToReimport, int32 BatchSize);
+};
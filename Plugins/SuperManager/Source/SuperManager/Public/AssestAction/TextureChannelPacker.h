@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTexture2D;
+
+/**
+ * Packs separate grayscale maps into one BGRA8 texture on the CPU.
+ * Interleaving runs on SIMD registers and is split into row bands across worker threads.
+ */
+class SUPERMANAGER_API FTextureChannelPacker
+{
+public:
+
+	//Reads source mip 0 as raw 8 bit gray values, without any gamma conversion.
+	static bool ReadSourceAsGray8(UTexture2D* SourceTexture, TArray64<uint8>& OutPixels, int32& OutSizeX, int32& OutSizeY);
+
+	//Writes R = occlusion, G = roughness, B = metallic, A = 255. All inputs must be SizeX * SizeY.
+	static void InterleaveORM(const uint8* OcclusionPixels, const uint8* RoughnessPixels, const uint8* MetallicPixels,
+		int32 SizeX, int32 SizeY, TArray64<uint8>& OutBGRA8Pixels);
+
+	//Creates a new linear TC_Masks texture asset from BGRA8 pixels.
+	static UTexture2D* CreatePackedTexture(const FString& TextureName, const FString& PackagePath,
+		int32 SizeX, int32 SizeY, const TArray64<uint8>& BGRA8Pixels);
+
+private:
+
+	static constexpr int32 RowsPerBand = 64;
+
+	static void InterleaveRow(const uint8* OcclusionRow, const uint8* RoughnessRow, const uint8* MetallicRow,
+		uint8* OutRow, int32 NumOfPixels);
+};
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+
+enum class ETextureAuditFlags : uint8
+{
+	None = 0,
+	NonPowerOfTwo = 1 << 0,
+	NeverStream = 1 << 1,
+	NoMips = 1 << 2,
+	Oversized = 1 << 3
+};
+ENUM_CLASS_FLAGS(ETextureAuditFlags);
+
+//Memory figures of one texture as cooked with its current settings, and what the suggested fix would save.
+struct FTextureMemoryEstimate
+{
+	int32 SizeX = 0;
+
+	int32 SizeY = 0;
+
+	//Always in memory, the whole texture when it cannot stream, the mip tail when it can.
+	int64 ResidentBytes = 0;
+
+	//Mips the streamer loads on demand.
+	int64 StreamingBytes = 0;
+
+	//Resident memory freed plus streaming pool demand removed once fixed.
+	int64 SavedBytes = 0;
+
+	ETextureAuditFlags Flags = ETextureAuditFlags::None;
+};
+
+/**
+ * Estimates texture memory from Asset Registry tags, so a folder of textures can be audited without loading any.
+ * Tags a texture does not write are taken as their defaults.
+ */
+class SUPERMANAGER_API FTextureMemoryAudit
+{
+public:
+
+	//Returns false when the asset is not a texture with known dimensions.
+	static bool EstimateFromTags(const FAssetData& AssetData, int32 MaxRecommendedSize, FTextureMemoryEstimate& OutEstimate);
+
+	//Caps oversized textures and turns streaming and mips on where they are missing, rebuilt asynchronously in one batch.
+	//Saves the changed textures and returns their packages, textures already fixed, failing to load or failing to save are left out.
+	static TArray<FName> ApplyFixes(const TArray<FAssetData>& TexturesData, int32 MaxRecommendedSize);
+
+	static FString DescribeFlags(ETextureAuditFlags Flags);
+
+private:
+
+	static int32 GetBitsPerPixel(const FString& CompressionName, bool bHasAlpha);
+
+	//Bytes of every mip whose larger side is at most LargestMipSize.
+	static int64 GetMipChainBytes(int32 SizeX, int32 SizeY, int32 BitsPerPixel, bool bHasMips, int32 LargestMipSize);
+};
@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/TextureDefines.h"
+#include "AssestAction/TextureSuffixMatcher.h"
+
+class UTexture2D;
+
+struct FTextureRoleAnalysis
+{
+	bool bIsValid = false;
+
+	ETextureRole Role = ETextureRole::None;
+
+	//Mean | |2c - 1|^2 - 1 |, close to zero for tangent space normals.
+	float NormalLengthError = 1.f;
+
+	//Mean difference between channels, close to zero for grayscale data.
+	float Chroma = 0.f;
+
+	float MeanLuminance = 0.f;
+
+	//Share of samples in the darkest and brightest histogram bins, high for binary masks.
+	float ExtremeFraction = 0.f;
+};
+
+/**
+ * Guesses what a texture is used for from the pixels of a small sample grid.
+ * Source mips are read under read only locks on worker threads, the analysis runs on vector registers.
+ */
+class SUPERMANAGER_API FTextureRoleAnalyzer
+{
+public:
+
+	static constexpr int32 SampleGridSize = 64;
+
+	//Point samples the smallest source mip that still covers the sample grid, in the format it is stored in.
+	static bool ReadSamples(UTexture2D* Texture, TArray<FColor>& OutSamples);
+
+	//Reads every texture on worker threads, OutSampleSets matches Textures by index and is empty where a source could not be read.
+	static void ReadSampleSets(const TArray<UTexture2D*>& Textures, TArray<TArray<FColor>>& OutSampleSets);
+
+	static FTextureRoleAnalysis AnalyzeSamples(TConstArrayView<FColor> Samples);
+
+	//Analyses every sample set in parallel, OutAnalyses matches SampleSets by index.
+	static void AnalyzeSampleSets(const TArray<TArray<FColor>>& SampleSets, TArray<FTextureRoleAnalysis>& OutAnalyses);
+
+	//False when the pixels contradict the role given by the name, ORM and unnamed textures are never contradicted.
+	static bool IsNameRoleConsistent(ETextureRole NameRole, const FTextureRoleAnalysis& Analysis);
+
+	static void GetSuggestedSettings(ETextureRole Role, TextureCompressionSettings& OutCompression, bool& bOutSRGB);
+
+private:
+
+	static constexpr int32 HistogramBins = 16;
+};
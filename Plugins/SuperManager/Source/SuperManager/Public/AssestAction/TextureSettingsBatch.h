@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/TextureDefines.h"
+#include "UObject/ObjectKey.h"
+
+class UTexture;
+
+/**
+ * Collects compression and sRGB changes for many textures and applies them in one go.
+ * Every rebuild is queued on the texture compiler, which runs them in parallel off the game thread.
+ */
+class SUPERMANAGER_API FTextureSettingsBatch
+{
+public:
+
+	//Returns false when the texture already uses these settings and nothing was queued.
+	bool Add(UTexture* Texture, TextureCompressionSettings Compression, bool bSRGB);
+
+	//Queues streaming friendly settings. A MaxTextureSize of 0 keeps the current size.
+	//Returns false when the texture already uses these settings and nothing was queued.
+	bool AddStreamingFix(UTexture* Texture, int32 MaxTextureSize, bool bEnableStreaming, bool bGenerateMips);
+
+	int32 Num() const { return PendingSettings.Num(); }
+
+	//Applies every queued change and shows a notification until the texture compiler catches up.
+	//Returns the textures that were changed.
+	TArray<UTexture*> Apply();
+
+private:
+
+	//Unset values are left as they are on the texture.
+	struct FPendingTextureSettings
+	{
+		TWeakObjectPtr<UTexture> Texture;
+		TOptional<TextureCompressionSettings> Compression;
+		TOptional<bool> bSRGB;
+		TOptional<int32> MaxTextureSize;
+		TOptional<bool> bNeverStream;
+		TOptional<TextureMipGenSettings> MipGenSettings;
+
+		bool IsAppliedTo(const UTexture* InTexture) const;
+	};
+
+	//Keyed on the texture, so merging a request is one lookup however big the batch is.
+	TMap<TObjectKey<UTexture>, FPendingTextureSettings> PendingSettings;
+
+	//A later request for the same texture is merged into the earlier one.
+	FPendingTextureSettings& FindOrAddSettings(UTexture* Texture);
+
+	static void ShowCompileProgress(int32 NumOfChangedTextures);
+};
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ETextureRole : uint8
+{
+	None,
+	BaseColor,
+	Metallic,
+	Roughness,
+	Normal,
+	AmbientOcclusion,
+	ORM
+};
+
+inline const TCHAR* LexToString(ETextureRole Role)
+{
+	switch (Role)
+	{
+	case ETextureRole::BaseColor: return TEXT("BaseColor");
+	case ETextureRole::Metallic: return TEXT("Metallic");
+	case ETextureRole::Roughness: return TEXT("Roughness");
+	case ETextureRole::Normal: return TEXT("Normal");
+	case ETextureRole::AmbientOcclusion: return TEXT("AmbientOcclusion");
+	case ETextureRole::ORM: return TEXT("ORM");
+	default: return TEXT("None");
+	}
+}
+
+/**
+ * Aho-Corasick automaton compiled from every supported texture suffix.
+ * Classifies a texture name in one case-insensitive pass, longest suffix wins and
+ * ties go to the role whose suffixes were added first.
+ */
+class SUPERMANAGER_API FTextureSuffixMatcher
+{
+public:
+
+	void Reset();
+
+	void AddSuffixes(const TArray<FString>& Suffixes, ETextureRole Role);
+
+	//Builds the transition table, must be called after the last AddSuffixes.
+	void Compile();
+
+	//Returns the role and the name with the matched suffix (and anything after it) stripped.
+	bool Classify(FStringView TextureName, ETextureRole& OutRole, FString& OutBaseName) const;
+
+	ETextureRole ClassifyRole(FStringView TextureName) const;
+
+private:
+
+	//Names are matched on 7 bit ASCII, anything else folds into one extra symbol.
+	static constexpr int32 AlphabetSize = 129;
+
+	struct FSuffixPattern
+	{
+		FString Suffix;
+		ETextureRole Role = ETextureRole::None;
+	};
+
+	TArray<FSuffixPattern> Patterns;
+
+	//Dense goto table, NumStates * AlphabetSize.
+	TArray<int32> Transitions;
+
+	//Best pattern ending at each state, following dictionary links. INDEX_NONE when there is none.
+	TArray<int32> StateOutputs;
+
+	static int32 ToSymbol(TCHAR Character);
+
+	bool IsBetterPattern(int32 PatternIndex, int32 OtherPatternIndex) const;
+
+	//Returns the pattern index and where it starts in the name.
+	int32 FindBestMatch(FStringView TextureName, int32& OutMatchStart) const;
+};
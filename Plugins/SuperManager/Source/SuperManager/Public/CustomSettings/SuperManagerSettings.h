@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "SuperManagerSettings.generated.h"
+
+/**
+ * Project settings for Super Manager, found under Project Settings > Plugins > Super Manager.
+ */
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Super Manager"))
+class SUPERMANAGER_API USuperManagerSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	USuperManagerSettings();
+
+	virtual FName GetCategoryName() const override { return FName("Plugins"); }
+
+	//Naming prefix per asset class, a class without an entry uses the prefix of its nearest ancestor.
+	UPROPERTY(config, EditAnywhere, Category = "Naming Convention", meta = (AllowAbstract = "true"))
+	TMap<TSoftClassPtr<UObject>, FString> AssetPrefixes;
+
+	//Textures larger than this on either side are flagged as oversized and capped to it when fixed.
+	UPROPERTY(config, EditAnywhere, Category = "Texture Audit", meta = (ClampMin = "64", ClampMax = "16384"))
+	int32 MaxRecommendedTextureSize = 2048;
+
+	//Keeps unused asset, empty folder and naming results for /Game up to date while the editor idles,
+	//so the menu actions can answer without scanning.
+	UPROPERTY(config, EditAnywhere, Category = "Background Audit")
+	bool bEnableBackgroundAudit = false;
+
+	//Time the background audit may take from each editor frame.
+	UPROPERTY(config, EditAnywhere, Category = "Background Audit", meta = (ClampMin = "0.1", ClampMax = "16.0", Units = "ms", EditCondition = "bEnableBackgroundAudit"))
+	float BackgroundAuditBudgetMs = 1.f;
+};
@@ -3,12 +3,22 @@
 #pragma once
 
 #include "Widgets/SCompoundWidget.h"
+#include "AssestAction/AssetRowTable.h"
+
+//Extra figure shown next to a listed asset, keyed by package name in the tab.
+struct FAssetListMetric
+{
+	//What the list is sorted by.
+	int64 Value = 0;
+
+	FString Text;
+};
 
 class SAdvanceDeletionTab : public SCompoundWidget
 {
 	SLATE_BEGIN_ARGS(SAdvanceDeletionTab){}
 
-	SLATE_ARGUMENT(TArray<TSharedPtr<FAssetData>>,AssetsDataToStore)
+	SLATE_ARGUMENT(TSharedPtr<FAssetRowTable>, AssetRows)
 
 	SLATE_ARGUMENT(FString, CurrentSelectedFolder)
 
@@ -20,22 +30,45 @@ public:
 
 private:
 
-	TArray<TSharedPtr<FAssetData>> StoredAssetsData;
+	//Every asset under the folder, listings pick rows out of it by index.
+	TSharedPtr<FAssetRowTable> AssetRows;
 
-	TSharedPtr< SListView< TSharedPtr <FAssetData> > > ConstructedAssetListView;
+	TSharedPtr< SListView< FAssetRowTable::FRowItem > > ConstructedAssetListView;
 
-	TArray<TSharedPtr<FAssetData>> AssetsDataToDeleteArray;
+	TArray<int32> SelectedRows;
 
 	TArray<TSharedRef<SCheckBox>> CheckBoxesArray;
 
-	TArray<TSharedPtr<FAssetData>> DisplayedAssetData;
+	TArray<FAssetRowTable::FRowItem> DisplayedItems;
 
 	FSlateFontInfo GetEmboseedTextFont() const { return FCoreStyle::Get().GetFontStyle(FName("EmbossedText")); }
 
-	TSharedRef< SListView< TSharedPtr <FAssetData> > > ConstructAssetListView();
+	TSharedRef< SListView< FAssetRowTable::FRowItem > > ConstructAssetListView();
 	
 	void RefreshAssetListView();
 
+	void SetDisplayedRows(const TArray<int32>& RowsToDisplay);
+
+	//Drops rows from the table and the listing once their assets are gone.
+	void RemoveDeletedRows(const TArray<int32>& DeletedRows);
+
+	FString CurrentListingOption;
+
+#pragma region MetricForAssetListView
+
+	//Filled by listings that measure something, empty otherwise.
+	TMap<FName, FAssetListMetric> DisplayedMetrics;
+
+	bool bSortMetricDescending = true;
+
+	void SortDisplayedAssetsByMetric();
+
+	TSharedRef<SButton> ConstructSortByMetricButton();
+
+	FReply OnSortByMetricButtonClicked();
+
+#pragma endregion
+
 #pragma region ComboBoxForListingCondition
 
 	TArray<TSharedPtr <FString>> ComboSourceItems;
@@ -56,20 +89,20 @@ private:
 
 #pragma region RowWidgetForAssetListView
 
-	TSharedRef<ITableRow> OnGenerateRowForList(TSharedPtr<FAssetData>AssetDataToDisplay,
+	TSharedRef<ITableRow> OnGenerateRowForList(FAssetRowTable::FRowItem ItemToDisplay,
 		const TSharedRef<STableViewBase>& OwnerTable);
 
-	void OnRowWidgetMouseButtonClicked(TSharedPtr<FAssetData> ClickedData);
+	void OnRowWidgetMouseButtonClicked(FAssetRowTable::FRowItem ClickedItem);
 
-	TSharedRef<SCheckBox> ConstructCheckBox(const TSharedPtr<FAssetData>&AssetDataToDisplay);
+	TSharedRef<SCheckBox> ConstructCheckBox(int32 RowToDisplay);
 
 	TSharedRef<STextBlock> ConstructTextForRowWidget(const FString& TextContent, const FSlateFontInfo& FontToUse);
 
-	TSharedRef<SButton> ConstructButtonForRowWidget(const TSharedPtr<FAssetData>& AssetDataToDisplay);
+	TSharedRef<SButton> ConstructButtonForRowWidget(int32 RowToDisplay);
 
-	void OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData);
+	void OnCheckBoxStateChanged(ECheckBoxState NewState, int32 Row);
 
-	FReply OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAssetData);
+	FReply OnDeleteButtonClicked(int32 ClickedRow);
 
 #pragma endregion
 
@@ -81,10 +114,12 @@ private:
 	TSharedRef<SButton> ConstructDeleteAllButton();
 	TSharedRef<SButton> ConstructSelectAllButton();
 	TSharedRef<SButton> ConstructDeselectAllButton();
+	TSharedRef<SButton> ConstructFixTexturesButton();
 
 	FReply OnDeleteAllButtonClicked();
 	FReply OnSelectAllButtonClicked();
 	FReply OnDeselectAllButtonClicked();
+	FReply OnFixTexturesButtonClicked();
 
 
 	TSharedRef<STextBlock> ConstructTextForTabButtons(const FString& TextContent);
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "AssetRegistry/AssetData.h"
+
+//Cost figures of one material, gathered without keeping the material loaded.
+struct FMaterialCostEntry
+{
+	FAssetData AssetData;
+
+	int32 NumUsageFlags = 0;
+
+	int32 NumStaticSwitches = 0;
+
+	int32 NumStaticComponentMasks = 0;
+
+	//Upper bound of shader maps, usages times every static switch and mask combination.
+	int64 NumPermutations = 1;
+
+	int32 NumSamplers = 0;
+
+	int32 NumPixelInstructions = 0;
+
+	int32 NumVertexInstructions = 0;
+};
+
+class SMaterialCostReportTab : public SCompoundWidget
+{
+	SLATE_BEGIN_ARGS(SMaterialCostReportTab){}
+
+	SLATE_ARGUMENT(TArray<TSharedPtr<FMaterialCostEntry>>, EntriesToStore)
+
+	SLATE_ARGUMENT(FString, CurrentSelectedFolder)
+
+	SLATE_END_ARGS()
+
+public:
+
+	void Construct(const FArguments& InArgs);
+
+private:
+
+	TArray<TSharedPtr<FMaterialCostEntry>> StoredEntries;
+
+	TSharedPtr< SListView< TSharedPtr <FMaterialCostEntry> > > ConstructedEntryListView;
+
+	FName SortColumnId;
+
+	EColumnSortMode::Type SortMode = EColumnSortMode::Descending;
+
+	FSlateFontInfo GetEmboseedTextFont() const { return FCoreStyle::Get().GetFontStyle(FName("EmbossedText")); }
+
+	TSharedRef< SListView< TSharedPtr <FMaterialCostEntry> > > ConstructEntryListView();
+
+	TSharedRef<ITableRow> OnGenerateRowForEntry(TSharedPtr<FMaterialCostEntry> EntryToDisplay,
+		const TSharedRef<STableViewBase>& OwnerTable);
+
+	void OnEntryMouseButtonClicked(TSharedPtr<FMaterialCostEntry> ClickedEntry);
+
+#pragma region Sorting
+
+	EColumnSortMode::Type GetColumnSortMode(FName ColumnId) const;
+
+	void OnColumnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type NewSortMode);
+
+	void SortEntries();
+
+#pragma endregion
+};
@@ -32,6 +32,12 @@ private:
 
 	void OnAdvanceDeletionButtonClicked();
 
+	void OnMaterialCostReportButtonClicked();
+
+	void OnAuditNamingConventionButtonClicked();
+
+	void OnReimportChangedSourcesButtonClicked();
+
 	void FixUpRedirectors();
 
 #pragma endregion ContentBrowserMenuExtention
@@ -45,13 +51,30 @@ private:
 
 	TSharedRef<SDockTab> OnSpawnAdvanceDeletionTab(const FSpawnTabArgs& SpawnTab);
 
-	TArray<TSharedPtr<FAssetData>> GetAllAssetDataUnderSelectedFolder();
+	TSharedRef<class FAssetRowTable> GetAssetRowsUnderSelectedFolder();
 
 	void OnAdvanceDeletionTabClosed(TSharedRef<SDockTab> TabToClose);
 
 #pragma endregion
 
 
+#pragma region MaterialCostReport
+
+	//Folder the report tab was opened for, the selection is cleared by the advance deletion tab.
+	FString MaterialCostReportFolder;
+
+	//Gathered by the menu action before the tab is invoked.
+	TArray<TSharedPtr<struct FMaterialCostEntry>> MaterialCostEntries;
+
+	void RegisterMaterialCostReportTab();
+
+	TSharedRef<SDockTab> OnSpawnMaterialCostReportTab(const FSpawnTabArgs& SpawnTab);
+
+	TArray<TSharedPtr<struct FMaterialCostEntry>> GatherMaterialCostEntries(const FString& FolderPath);
+
+#pragma endregion
+
+
 #pragma region LevelEditorMenuExtension
 
 	void InitLevelEditorExtention();
@@ -91,6 +114,13 @@ private:
 
 #pragma endregion
 
+#pragma region BackgroundAudit
+
+	//Cached unused, empty folder and naming results, the menu actions use them while they are current.
+	TUniquePtr<class FBackgroundAssetAuditor> BackgroundAuditor;
+
+#pragma endregion
+
 #pragma region SceneOutlinerExtension
 
 	void InitSceneOutlinerColumnExtension();
@@ -112,12 +142,27 @@ public:
 
 	bool DeleteMultipleAssetsForAssetList(const TArray<FAssetData>& AssetsToDelete);
 
-	void ListUnusedAssetsForAssetList(const TArray<TSharedPtr <FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr <FAssetData>>& OutUnusedAssetsData);
+	//Listings take rows of the tab's table and give back the rows that pass, nothing is copied.
+	void ListUnusedAssetsForAssetList(const class FAssetRowTable& AssetRows, const TArray<int32>& RowsToFilter, TArray<int32>& OutUnusedRows);
 
-	void ListSameNameAssetsForAssetList(const TArray<TSharedPtr <FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr <FAssetData>>& OutSameNameAssetsData);
+	void ListSameNameAssetsForAssetList(const class FAssetRowTable& AssetRows, const TArray<int32>& RowsToFilter, TArray<int32>& OutSameNameRows);
+
+	void ListTextureMemoryForAssetList(const class FAssetRowTable& AssetRows, const TArray<int32>& RowsToFilter, TArray<int32>& OutFlaggedTextureRows,
+		TMap<FName, struct FAssetListMetric>& OutMetrics);
+
+	TArray<FName> FixTexturesForAssetList(const TArray<FAssetData>& TexturesToFix);
+
+	void ListReferenceCyclesForAssetList(const class FAssetRowTable& AssetRows, const TArray<int32>& RowsToFilter, TArray<int32>& OutRows,
+		TMap<FName, struct FAssetListMetric>& OutMetrics);
+
+	void ListDependencyClosuresForAssetList(const class FAssetRowTable& AssetRows, const TArray<int32>& RowsToFilter, TArray<int32>& OutRows,
+		TMap<FName, struct FAssetListMetric>& OutMetrics);
 
 	void SyncCBToClickedAssetForAssetList(const FString& AssetPathToSync);
 
+	//Searches config, source and plugin text files for asset paths, the references the registry misses.
+	class FPathLiteralScanner ScanPathLiterals();
+
 #pragma endregion
 
 	bool CheckIsActorSelectionLocked(AActor* ActorToProcess);
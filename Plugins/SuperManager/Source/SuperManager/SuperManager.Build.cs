@@ -48,6 +48,10 @@ public class SuperManager : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"ImageCore",
+				"MaterialEditor",
+				"DeveloperSettings",
+				"SourceControl",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);